@@ -5,72 +5,2372 @@
  * This is much faster than the O(n^3) required to compute A * B.
  * The result is correct with probability >= 1/2.
  * To get error probability <= 1/2^k, run this k times.
+ *
+ * Matrices are stored flat and row-major with every row aligned to a
+ * cache line, so a verification pass streams memory instead of chasing
+ * one heap pointer per row. Compile with -mavx2 or -mavx512f (or
+ * -march=native) to enable the SIMD dot-product kernels.
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>       // For std::random_device, std::mt19937_64
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <new>          // For aligned operator new
+#include <algorithm>
+#include <cmath>        // For std::abs
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
+#include <fstream>
+#include <cstring>      // For std::memcpy / std::memcmp
+#include <cstdio>       // For std::remove
+#include <filesystem>   // For the demo's temporary files
+
+// POSIX memory mapping for the out-of-core verifier
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Every matrix row starts on a cache-line boundary.
+constexpr std::size_t kAlignment = 64;
+
+/**
+ * @brief Minimal allocator returning kAlignment-aligned storage.
+ */
+template <typename T>
+struct AlignedAllocator {
+    using value_type = T;
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(kAlignment)));
+    }
+    void deallocate(T* ptr, std::size_t) {
+        ::operator delete(ptr, std::align_val_t(kAlignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U>&) const { return false; }
+};
+
+// Define a Vector as a 1D vector
+using Vector = std::vector<int>;
+
+/**
+ * @brief Dense row-major matrix in a single aligned allocation.
+ *
+ * Rows are padded to a multiple of kAlignment bytes (the padding is zero),
+ * so row(i) is always cache-line aligned and the matrix is one contiguous
+ * block of memory. T is the element type (int8_t ... double).
+ */
+template <typename T>
+class BasicMatrix {
+public:
+    using value_type = T;
+
+    BasicMatrix() = default;
+
+    BasicMatrix(std::size_t rows, std::size_t cols)
+        : rows_(rows), cols_(cols), stride_(paddedStride(cols)), data_(rows * stride_, T{}) {}
+
+    BasicMatrix(std::initializer_list<std::initializer_list<T>> init)
+        : BasicMatrix(init.size(), init.size() == 0 ? 0 : init.begin()->size()) {
+        std::size_t i = 0;
+        for (const auto& values : init) {
+            std::size_t j = 0;
+            for (T val : values) {
+                if (j < cols_) (*this)(i, j) = val;
+                ++j;
+            }
+            ++i;
+        }
+    }
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    // Distance in elements between the starts of consecutive rows
+    std::size_t stride() const { return stride_; }
+
+    T* row(std::size_t i) { return data_.data() + i * stride_; }
+    const T* row(std::size_t i) const { return data_.data() + i * stride_; }
+
+    T& operator()(std::size_t i, std::size_t j) { return row(i)[j]; }
+    T operator()(std::size_t i, std::size_t j) const { return row(i)[j]; }
+
+private:
+    static std::size_t paddedStride(std::size_t cols) {
+        const std::size_t perLine = kAlignment / sizeof(T);
+        return (cols + perLine - 1) / perLine * perLine;
+    }
+
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    std::size_t stride_ = 0;
+    std::vector<T, AlignedAllocator<T>> data_;
+};
+
+// The default element type used throughout this file
+using Matrix = BasicMatrix<int>;
+
+/**
+ * @brief Accumulator type used when verifying products of T.
+ *
+ * Narrow integers widen to 32 bits (arithmetic wraps modulo 2^32, which is
+ * still a valid ring for Freivalds' check); fp32 products are checked in
+ * double so our own rounding stays well below that of the producer.
+ */
+template <typename T> struct FreivaldsTraits;
+template <> struct FreivaldsTraits<std::int8_t> { using Accumulator = std::int32_t; };
+template <> struct FreivaldsTraits<std::int16_t> { using Accumulator = std::int32_t; };
+template <> struct FreivaldsTraits<std::int32_t> { using Accumulator = std::int32_t; };
+template <> struct FreivaldsTraits<float> { using Accumulator = double; };
+template <> struct FreivaldsTraits<double> { using Accumulator = double; };
+
+#if defined(__AVX512F__)
+inline std::uint32_t horizontalSum(__m512i v) {
+    alignas(64) std::uint32_t lanes[16];
+    _mm512_store_si512(lanes, v);
+    std::uint32_t sum = 0;
+    for (std::uint32_t lane : lanes) sum += lane;
+    return sum;
+}
+#endif
+#if defined(__AVX2__)
+inline std::uint32_t horizontalSum(__m256i v) {
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return static_cast<std::uint32_t>(_mm_cvtsi128_si32(half));
+}
+#endif
+
+/**
+ * @brief Computes the dot product of a[0..n) and x[0..n).
+ * Arithmetic wraps modulo 2^32 in every code path, so the AVX-512, AVX2
+ * and scalar kernels return bit-identical results.
+ */
+inline int dotProduct(const int* a, const int* x, std::size_t n) {
+    std::size_t j = 0;
+    std::uint32_t sum = 0;
+#if defined(__AVX512F__)
+    __m512i acc0 = _mm512_setzero_si512();
+    __m512i acc1 = _mm512_setzero_si512();
+    for (; j + 32 <= n; j += 32) {
+        __m512i a0 = _mm512_loadu_si512(a + j);
+        __m512i a1 = _mm512_loadu_si512(a + j + 16);
+        __m512i x0 = _mm512_loadu_si512(x + j);
+        __m512i x1 = _mm512_loadu_si512(x + j + 16);
+        acc0 = _mm512_add_epi32(acc0, _mm512_mullo_epi32(a0, x0));
+        acc1 = _mm512_add_epi32(acc1, _mm512_mullo_epi32(a1, x1));
+    }
+    sum = horizontalSum(_mm512_add_epi32(acc0, acc1));
+#elif defined(__AVX2__)
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    for (; j + 16 <= n; j += 16) {
+        __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + j));
+        __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + j + 8));
+        __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + j));
+        __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + j + 8));
+        acc0 = _mm256_add_epi32(acc0, _mm256_mullo_epi32(a0, x0));
+        acc1 = _mm256_add_epi32(acc1, _mm256_mullo_epi32(a1, x1));
+    }
+    sum = horizontalSum(_mm256_add_epi32(acc0, acc1));
+#endif
+    // Scalar tail (or the whole row when no SIMD is available)
+    for (; j < n; ++j) {
+        sum += static_cast<std::uint32_t>(a[j]) * static_cast<std::uint32_t>(x[j]);
+    }
+    return static_cast<int>(sum);
+}
+
+/**
+ * @brief Widening dot product of an int8 row with an int32 vector.
+ * Each 8-bit element is sign-extended in registers, so the row is read at
+ * a quarter of the bandwidth of an int32 row.
+ */
+inline std::int32_t dotProduct(const std::int8_t* a, const std::int32_t* x, std::size_t n) {
+    std::size_t j = 0;
+    std::uint32_t sum = 0;
+#if defined(__AVX512F__)
+    __m512i acc = _mm512_setzero_si512();
+    for (; j + 16 <= n; j += 16) {
+        // All-ones maskz form: same instruction, but avoids a spurious GCC
+        // -Wmaybe-uninitialized from the unmasked intrinsic's header
+        __m512i va = _mm512_maskz_cvtepi8_epi32(0xFFFF, _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + j)));
+        acc = _mm512_add_epi32(acc, _mm512_mullo_epi32(va, _mm512_loadu_si512(x + j)));
+    }
+    sum = horizontalSum(acc);
+#elif defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+    for (; j + 8 <= n; j += 8) {
+        __m256i va = _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + j)));
+        __m256i vx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + j));
+        acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(va, vx));
+    }
+    sum = horizontalSum(acc);
+#endif
+    for (; j < n; ++j) {
+        sum += static_cast<std::uint32_t>(a[j]) * static_cast<std::uint32_t>(x[j]);
+    }
+    return static_cast<std::int32_t>(sum);
+}
+
+/**
+ * @brief Widening dot product of an int16 row with an int32 vector.
+ */
+inline std::int32_t dotProduct(const std::int16_t* a, const std::int32_t* x, std::size_t n) {
+    std::size_t j = 0;
+    std::uint32_t sum = 0;
+#if defined(__AVX512F__)
+    __m512i acc = _mm512_setzero_si512();
+    for (; j + 16 <= n; j += 16) {
+        __m512i va = _mm512_maskz_cvtepi16_epi32(0xFFFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + j)));
+        acc = _mm512_add_epi32(acc, _mm512_mullo_epi32(va, _mm512_loadu_si512(x + j)));
+    }
+    sum = horizontalSum(acc);
+#elif defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+    for (; j + 8 <= n; j += 8) {
+        __m256i va = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + j)));
+        __m256i vx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + j));
+        acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(va, vx));
+    }
+    sum = horizontalSum(acc);
+#endif
+    for (; j < n; ++j) {
+        sum += static_cast<std::uint32_t>(a[j]) * static_cast<std::uint32_t>(x[j]);
+    }
+    return static_cast<std::int32_t>(sum);
+}
+
+/**
+ * @brief Scalar dot product for the remaining element/accumulator pairs.
+ * Integer accumulators wrap modulo 2^bits like the SIMD kernels.
+ */
+template <typename T, typename Acc>
+Acc dotProduct(const T* a, const Acc* x, std::size_t n) {
+    if constexpr (std::is_integral_v<Acc>) {
+        using U = std::make_unsigned_t<Acc>;
+        U sum = 0;
+        for (std::size_t j = 0; j < n; ++j) {
+            sum += static_cast<U>(static_cast<Acc>(a[j])) * static_cast<U>(x[j]);
+        }
+        return static_cast<Acc>(sum);
+    } else {
+        Acc sum = 0;
+        for (std::size_t j = 0; j < n; ++j) {
+            sum += static_cast<Acc>(a[j]) * x[j];
+        }
+        return sum;
+    }
+}
+
+/**
+ * @brief Computes (a . x, |a| . xAbs) in one pass over a, where xAbs >= 0
+ * bounds |x| entrywise. The second value feeds the floating-point error
+ * bound of the tolerant comparison.
+ */
+template <typename T, typename Acc>
+std::pair<Acc, Acc> dotProductWithMagnitude(const T* a, const Acc* x, const Acc* xAbs, std::size_t n) {
+    Acc sum = 0;
+    Acc magnitude = 0;
+    for (std::size_t j = 0; j < n; ++j) {
+        Acc aj = static_cast<Acc>(a[j]);
+        sum += aj * x[j];
+        magnitude += std::abs(aj) * xAbs[j];
+    }
+    return {sum, magnitude};
+}
+
+/**
+ * @brief Computes y[0..n) += a * x[0..n), wrapping modulo 2^32 like dotProduct.
+ */
+inline void axpy(int a, const int* x, int* y, std::size_t n) {
+    std::size_t j = 0;
+#if defined(__AVX512F__)
+    __m512i va = _mm512_set1_epi32(a);
+    for (; j + 16 <= n; j += 16) {
+        __m512i vx = _mm512_loadu_si512(x + j);
+        __m512i vy = _mm512_loadu_si512(y + j);
+        _mm512_storeu_si512(y + j, _mm512_add_epi32(vy, _mm512_mullo_epi32(va, vx)));
+    }
+#elif defined(__AVX2__)
+    __m256i va = _mm256_set1_epi32(a);
+    for (; j + 8 <= n; j += 8) {
+        __m256i vx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + j));
+        __m256i vy = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + j));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + j), _mm256_add_epi32(vy, _mm256_mullo_epi32(va, vx)));
+    }
+#endif
+    for (; j < n; ++j) {
+        y[j] = static_cast<int>(static_cast<std::uint32_t>(y[j]) +
+                                static_cast<std::uint32_t>(a) * static_cast<std::uint32_t>(x[j]));
+    }
+}
+
+/**
+ * @brief Scalar axpy for the remaining element/accumulator pairs (the
+ * compiler vectorizes this simple loop on its own).
+ */
+template <typename T, typename Acc>
+void axpy(Acc a, const T* x, Acc* y, std::size_t n) {
+    if constexpr (std::is_integral_v<Acc>) {
+        using U = std::make_unsigned_t<Acc>;
+        for (std::size_t j = 0; j < n; ++j) {
+            y[j] = static_cast<Acc>(static_cast<U>(y[j]) + static_cast<U>(a) * static_cast<U>(static_cast<Acc>(x[j])));
+        }
+    } else {
+        for (std::size_t j = 0; j < n; ++j) {
+            y[j] += a * static_cast<Acc>(x[j]);
+        }
+    }
+}
+
+/**
+ * @brief Checks that A is n x m, B is m x p and C is n x p, with no
+ * dimension equal to zero.
+ */
+template <typename MA, typename MB, typename MC>
+bool productShapesMatch(const MA& A, const MB& B, const MC& C) {
+    return A.rows() != 0 && A.cols() != 0 && B.cols() != 0 &&
+           B.rows() == A.cols() && C.rows() == A.rows() && C.cols() == B.cols();
+}
+
+/**
+ * @brief Multiplies an n x m matrix by an m x 1 vector.
+ * @return An n x 1 vector (the result).
+ */
+template <typename T, typename Acc>
+std::vector<Acc> matrixVectorMultiply(const BasicMatrix<T>& M, const std::vector<Acc>& r) {
+    std::size_t n = M.rows();
+    std::vector<Acc> result(n, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        result[i] = dotProduct(M.row(i), r.data(), M.cols());
+    }
+    return result;
+}
+
+/**
+ * @brief Computes the row vector s^T * M for an n x m matrix M.
+ * Rows whose coefficient s[i] is zero are never read.
+ * @return A 1 x m vector (the result).
+ */
+template <typename T, typename Acc>
+std::vector<Acc> vectorMatrixMultiply(const std::vector<Acc>& s, const BasicMatrix<T>& M) {
+    // Accumulate over the padded width so axpy needs no scalar tail
+    std::vector<Acc> result(M.stride(), 0);
+    for (std::size_t i = 0; i < M.rows(); ++i) {
+        if (s[i] != 0) axpy(s[i], M.row(i), result.data(), M.stride());
+    }
+    result.resize(M.cols());
+    return result;
+}
+
+// --- Random {0, 1} vectors as packed bitmasks ---
+
+/**
+ * @brief A 64-bit generator seeded with 128 bits from std::random_device.
+ * The per-round error bounds assume r is uniform; a 32-bit clock seed would
+ * allow only 2^32 distinct vectors and repeat them for checks started in
+ * the same clock tick.
+ */
+inline std::mt19937_64 seededGenerator() {
+    std::random_device device;
+    std::seed_seq seeds{device(), device(), device(), device()};
+    return std::mt19937_64(seeds);
+}
+
+/**
+ * @brief A {0, 1} vector packed 64 entries to a word: entry j is bit
+ * j % 64 of words[j / 64]. Bits past size are always zero.
+ */
+struct BitVector {
+    std::size_t size = 0;
+    std::vector<std::uint64_t> words;
+
+    bool test(std::size_t j) const { return (words[j >> 6] >> (j & 63)) & 1; }
+};
+
+/**
+ * @brief Draws a uniformly random BitVector of length n using one
+ * generator call per 64 entries.
+ */
+BitVector randomBitVector(std::size_t n, std::mt19937_64& generator) {
+    BitVector bits;
+    bits.size = n;
+    bits.words.resize((n + 63) / 64);
+    for (auto& word : bits.words) {
+        word = generator();
+    }
+    if (n % 64 != 0) {
+        bits.words.back() &= (1ULL << (n % 64)) - 1; // Clear the bits past the end
+    }
+    return bits;
+}
+
+/**
+ * @brief Expands a BitVector into an explicit {0, 1} vector, for kernels
+ * that gather x[j] at arbitrary positions.
+ */
+template <typename Acc>
+std::vector<Acc> expandBits(const BitVector& bits) {
+    std::vector<Acc> values(bits.size);
+    for (std::size_t j = 0; j < bits.size; ++j) {
+        values[j] = static_cast<Acc>(bits.test(j));
+    }
+    return values;
+}
+
+/**
+ * @brief Sum of a[j] over the j whose bit is set in mask: a dot product
+ * with a {0, 1} vector, done with masked adds and no multiplications.
+ * Arithmetic wraps modulo 2^32 like dotProduct.
+ */
+inline int maskedRowSumInt32(const int* a, const std::uint64_t* mask, std::size_t n) {
+    std::size_t j = 0;
+    std::uint32_t sum = 0;
+#if defined(__AVX512F__)
+    // 16 lanes per step, so each step's mask bits lie inside one word
+    __m512i acc = _mm512_setzero_si512();
+    for (; j + 16 <= n; j += 16) {
+        __mmask16 lanes = static_cast<__mmask16>(mask[j >> 6] >> (j & 63));
+        acc = _mm512_mask_add_epi32(acc, lanes, acc, _mm512_loadu_si512(a + j));
+    }
+    sum = horizontalSum(acc);
+#elif defined(__AVX2__)
+    // Broadcast 8 mask bits and turn them into all-ones / all-zeros lanes
+    const __m256i laneBits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i acc = _mm256_setzero_si256();
+    for (; j + 8 <= n; j += 8) {
+        __m256i bits = _mm256_set1_epi32(static_cast<int>((mask[j >> 6] >> (j & 63)) & 0xFF));
+        __m256i lanes = _mm256_cmpeq_epi32(_mm256_and_si256(bits, laneBits), laneBits);
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + j));
+        acc = _mm256_add_epi32(acc, _mm256_and_si256(lanes, va));
+    }
+    sum = horizontalSum(acc);
+#endif
+    for (; j < n; ++j) {
+        std::uint32_t select = 0u - static_cast<std::uint32_t>((mask[j >> 6] >> (j & 63)) & 1);
+        sum += static_cast<std::uint32_t>(a[j]) & select;
+    }
+    return static_cast<int>(sum);
+}
+
+/**
+ * @brief Masked row sum accumulated in Acc, for any element type.
+ * int rows use the SIMD kernel above; other types select with a branch-free
+ * scalar loop.
+ */
+template <typename Acc, typename T>
+Acc maskedRowSum(const T* a, const std::uint64_t* mask, std::size_t n) {
+    if constexpr (std::is_same_v<T, int> && std::is_same_v<Acc, int>) {
+        return maskedRowSumInt32(a, mask, n);
+    } else if constexpr (std::is_integral_v<Acc>) {
+        using U = std::make_unsigned_t<Acc>;
+        U sum = 0;
+        for (std::size_t j = 0; j < n; ++j) {
+            U select = U{0} - static_cast<U>((mask[j >> 6] >> (j & 63)) & 1);
+            sum += static_cast<U>(static_cast<Acc>(a[j])) & select;
+        }
+        return static_cast<Acc>(sum);
+    } else {
+        Acc sum = 0;
+        for (std::size_t j = 0; j < n; ++j) {
+            sum += ((mask[j >> 6] >> (j & 63)) & 1) ? static_cast<Acc>(a[j]) : Acc{0};
+        }
+        return sum;
+    }
+}
+
+/**
+ * @brief Computes s^T * M for a {0, 1} vector s by adding up the rows of M
+ * that s selects. Unselected rows are never read.
+ * @return A 1 x m vector (the result).
+ */
+template <typename Acc, typename T>
+std::vector<Acc> selectedRowSum(const BitVector& s, const BasicMatrix<T>& M) {
+    using U = std::conditional_t<std::is_integral_v<Acc>, std::make_unsigned_t<Acc>, Acc>;
+    // Accumulate over the padded width so the loop needs no scalar tail
+    std::vector<U> sums(M.stride(), 0);
+    for (std::size_t i = 0; i < M.rows(); ++i) {
+        if (!s.test(i)) continue;
+        const T* row = M.row(i);
+        for (std::size_t j = 0; j < M.stride(); ++j) {
+            sums[j] += static_cast<U>(static_cast<Acc>(row[j]));
+        }
+    }
+    return std::vector<Acc>(sums.begin(), sums.begin() + M.cols());
+}
+
+/**
+ * @brief Fused check that (A * Br)[i] == (C * r)[i] for rows [begin, end),
+ * where r is a packed {0, 1} vector.
+ * Both values of a row are computed together, so neither product vector
+ * is materialized and the scan stops at the first differing row.
+ * @return true if every row agrees, false at the first mismatch.
+ */
+template <typename T, typename TC, typename Acc>
+bool rowsAgree(const BasicMatrix<T>& A, const std::vector<Acc>& Br, const BasicMatrix<TC>& C,
+               const BitVector& r, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        if (dotProduct(A.row(i), Br.data(), A.cols()) != maskedRowSum<Acc>(C.row(i), r.words.data(), C.cols())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Worst-case relative error of a length-k dot product evaluated in
+ * floating-point type F: gamma_k = k u / (1 - k u), u = eps / 2.
+ */
+template <typename F>
+double dotProductErrorBound(std::size_t k) {
+    double ku = static_cast<double>(k) * std::numeric_limits<F>::epsilon() / 2;
+    return ku < 1 ? ku / (1 - ku) : std::numeric_limits<double>::infinity();
+}
+
+/**
+ * @brief Verifies if A * B = C using Freivalds' technique (single iteration).
+ *
+ * A is n x m, B is m x p and C is n x p. A and B share element type T,
+ * C may be wider (e.g. int8 inputs with an int32 result), and Acc is the
+ * type both sides are evaluated in. The random {0, 1} vector is drawn 64
+ * bits at a time and kept packed, so every product with it is a masked
+ * sum rather than a multiply-add.
+ *
+ * Integer types are compared exactly. Both association orders stream
+ * every operand at most once, O(nm + mp + np), and the cheaper one for
+ * the given shape is used:
+ *  - right form A(Br) == Cr: draws p random entries and compares rows as
+ *    soon as they are computed, so a rejection usually costs only a
+ *    fraction of a pass;
+ *  - left form (s^T A)B == s^T C: draws n random entries and only reads
+ *    the rows of A and C selected by s, but must finish before comparing.
+ * The left form is chosen for short-wide products (n < p).
+ *
+ * Floating-point types always use the right form and accept a row when
+ * |(A Br)_i - (C r)_i| is within the forward error bound of computing C
+ * in T and both sides in Acc:
+ *   (gamma_{m+1}(T) + gamma_{m+p}(Acc)) * ((|A| |B| r)_i + (|C| r)_i).
+ * @return true if the two sides agree, false otherwise.
+ */
+template <typename T, typename TC, typename Acc = typename FreivaldsTraits<T>::Accumulator>
+bool freivaldsVerify(const BasicMatrix<T>& A, const BasicMatrix<T>& B, const BasicMatrix<TC>& C) {
+    if (!productShapesMatch(A, B, C)) {
+        return false; // Invalid dimensions
+    }
+    std::size_t n = A.rows();
+    std::size_t m = B.rows();
+    std::size_t p = B.cols();
+    bool leftForm = std::is_integral_v<Acc> && n < p;
+
+    // 1. Set up a high-quality 64-bit random number generator
+    std::mt19937_64 generator = seededGenerator();
+
+    // 2. Generate the random {0, 1} vector as a bitmask (length n or p)
+    BitVector r = randomBitVector(leftForm ? n : p, generator);
+
+    if constexpr (std::is_floating_point_v<Acc>) {
+        // 3. Compute B * r together with |B| * r  (O(mp))
+        std::vector<Acc> rValues = expandBits<Acc>(r);
+        std::vector<Acc> Br(m), BrAbs(m);
+        for (std::size_t i = 0; i < m; ++i) {
+            std::tie(Br[i], BrAbs[i]) = dotProductWithMagnitude(B.row(i), rValues.data(), rValues.data(), p);
+        }
+
+        // 4. Compare row by row against the forward error bound  (O(nm + np), early exit)
+        double gamma = dotProductErrorBound<T>(m + 1) + dotProductErrorBound<Acc>(m + p);
+        for (std::size_t i = 0; i < n; ++i) {
+            auto [lhs, lhsAbs] = dotProductWithMagnitude(A.row(i), Br.data(), BrAbs.data(), m);
+            auto [rhs, rhsAbs] = dotProductWithMagnitude(C.row(i), rValues.data(), rValues.data(), p);
+            if (!(std::abs(lhs - rhs) <= gamma * (lhsAbs + rhsAbs))) {
+                return false; // Also rejects NaN
+            }
+        }
+        return true;
+    } else {
+        if (leftForm) {
+            // 3. Compare (r^T A) B with r^T C  (O(nm + mp + np))
+            std::vector<Acc> rA = selectedRowSum<Acc>(r, A);
+            return vectorMatrixMultiply(rA, B) == selectedRowSum<Acc>(r, C);
+        }
+
+        // 3. Compute v1 = B * r with masked sums  (O(mp))
+        std::vector<Acc> Br(m);
+        for (std::size_t i = 0; i < m; ++i) {
+            Br[i] = maskedRowSum<Acc>(B.row(i), r.words.data(), p);
+        }
+
+        // 4. Compare (A * v1)[i] with (C * r)[i] row by row  (O(nm + np), early exit)
+        return rowsAgree(A, Br, C, r, 0, n);
+    }
+}
+
+/**
+ * @brief Multiplies an n x m matrix by a thin m x k panel.
+ *
+ * The inner dimension is processed in blocks of panel rows small enough to
+ * stay in L2, so every element of M is read from memory exactly once no
+ * matter how wide the panel is.
+ * @return An n x k matrix (the result).
+ */
+Matrix matrixPanelMultiply(const Matrix& M, const Matrix& X) {
+    std::size_t n = M.rows();
+    std::size_t k = X.cols();
+    Matrix result(n, k);
+
+    // Aim for a panel block of about 256 KiB
+    const std::size_t blockBytes = 256 * 1024;
+    std::size_t rowBytes = std::max<std::size_t>(X.stride() * sizeof(int), 1);
+    std::size_t blockRows = std::max<std::size_t>(blockBytes / rowBytes, 1);
+
+    // X and result share the same padded stride. Running axpy over the whole
+    // padded row keeps the SIMD loop free of a scalar tail; the padding of X
+    // is zero, so the padding of the result stays zero too.
+    std::size_t width = result.stride();
+
+    for (std::size_t jb = 0; jb < M.cols(); jb += blockRows) {
+        std::size_t je = std::min(jb + blockRows, M.cols());
+        for (std::size_t i = 0; i < n; ++i) {
+            const int* m = M.row(i);
+            int* out = result.row(i);
+            for (std::size_t j = jb; j < je; ++j) {
+                axpy(m[j], X.row(j), out, width);
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Runs k rounds of Freivalds' technique in a single pass.
+ *
+ * Draws one p x k panel R with {0, 1} entries and checks A(BR) == CR.
+ * Each column of R is an independent round, so the error probability is
+ * <= 1/2^k, but A, B and C are each streamed from memory only once.
+ * @return true if all k rounds agree, false otherwise.
+ */
+bool freivaldsVerifyBatch(const Matrix& A, const Matrix& B, const Matrix& C, std::size_t k) {
+    if (k == 0 || !productShapesMatch(A, B, C)) {
+        return false; // Invalid dimensions
+    }
+    std::size_t n = A.rows();
+    std::size_t p = B.cols();
+
+    // 1. One generator for all k rounds
+    std::mt19937_64 generator = seededGenerator();
+
+    // 2. Generate the random p x k panel R with {0, 1} entries, 64 per draw
+    Matrix R(p, k);
+    std::uint64_t bits = 0;
+    std::size_t bitsLeft = 0;
+    for (std::size_t i = 0; i < p; ++i) {
+        for (std::size_t j = 0; j < k; ++j) {
+            if (bitsLeft == 0) {
+                bits = generator();
+                bitsLeft = 64;
+            }
+            R(i, j) = static_cast<int>(bits & 1);
+            bits >>= 1;
+            --bitsLeft;
+        }
+    }
+
+    // 3. Compute A * (B * R) and C * R  (O((nm + mp + np) k), one read of each matrix)
+    Matrix A_BR = matrixPanelMultiply(A, matrixPanelMultiply(B, R));
+    Matrix CR = matrixPanelMultiply(C, R);
+
+    // 4. Compare the two n x k panels
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!std::equal(A_BR.row(i), A_BR.row(i) + k, CR.row(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- Freivalds over Z_p with p = 2^61 - 1 ---
+
+// The Mersenne prime 2^61 - 1: reduction needs only shifts and adds
+constexpr std::uint64_t kMersenne61 = (1ULL << 61) - 1;
+
+// A vector with entries in [0, 2^61 - 1)
+using ModVector = std::vector<std::uint64_t>;
+
+/**
+ * @brief Reduces x < 2^122 modulo 2^61 - 1 using 2^61 = 1 (mod p).
+ */
+inline std::uint64_t reduceMod61(unsigned __int128 x) {
+    std::uint64_t t = static_cast<std::uint64_t>(x & kMersenne61) + static_cast<std::uint64_t>(x >> 61);
+    t = (t & kMersenne61) + (t >> 61);
+    return t >= kMersenne61 ? t - kMersenne61 : t;
+}
+
+/**
+ * @brief Computes (a . x) mod 2^61 - 1 for int entries a and x in Z_p.
+ *
+ * Products are at most 2^92 in magnitude, so they are summed exactly in a
+ * signed 128-bit accumulator and reduced once at the end of the row (lazy
+ * reduction). This is exact for rows of up to 2^29 entries.
+ */
+inline std::uint64_t dotProductMod61(const int* a, const std::uint64_t* x, std::size_t n) {
+    __int128 acc = 0;
+    for (std::size_t j = 0; j < n; ++j) {
+        acc += static_cast<__int128>(a[j]) * static_cast<std::int64_t>(x[j]);
+    }
+    if (acc >= 0) return reduceMod61(static_cast<unsigned __int128>(acc));
+    std::uint64_t r = reduceMod61(static_cast<unsigned __int128>(-acc));
+    return r == 0 ? 0 : kMersenne61 - r;
+}
+
+/**
+ * @brief Multiplies a matrix by a vector over Z_p, p = 2^61 - 1.
+ * @return The result vector with entries in [0, p).
+ */
+ModVector matrixVectorMultiplyMod61(const Matrix& M, const ModVector& x) {
+    std::size_t n = M.rows();
+    ModVector result(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        result[i] = dotProductMod61(M.row(i), x.data(), M.cols());
+    }
+    return result;
+}
+
+/**
+ * @brief Verifies A * B = C over Z_p (p = 2^61 - 1) in a single round.
+ *
+ * Unlike the {0, 1} version, arithmetic cannot overflow and r is drawn
+ * uniformly from Z_p^p, so by Schwartz-Zippel a wrong product survives
+ * with probability <= 1/p < 2^-60. The check is exact for products whose
+ * true entries stay below p in magnitude; otherwise it verifies
+ * A * B = C (mod p).
+ * @return true if A(Br) == Cr (mod p), false otherwise.
+ */
+bool freivaldsVerifyModP(const Matrix& A, const Matrix& B, const Matrix& C) {
+    if (!productShapesMatch(A, B, C)) {
+        return false; // Invalid dimensions
+    }
+    std::size_t p = B.cols();
+
+    // 1. Set up a 64-bit random number generator
+    std::mt19937_64 generator = seededGenerator();
+    std::uniform_int_distribution<std::uint64_t> distribution(0, kMersenne61 - 1);
+
+    // 2. Generate random p x 1 vector r with entries from Z_p
+    ModVector r(p);
+    for (std::size_t i = 0; i < p; ++i) {
+        r[i] = distribution(generator);
+    }
+
+    // 3. Compute A * (B * r) and C * r over Z_p  (O(nm + mp + np))
+    ModVector A_Br = matrixVectorMultiplyMod61(A, matrixVectorMultiplyMod61(B, r));
+    ModVector Cr = matrixVectorMultiplyMod61(C, r);
+
+    // 4. Compare  (O(n))
+    return A_Br == Cr;
+}
+
+// --- Error localization after a failed check ---
+
+/**
+ * @brief Computes s^T * M over Z_p, p = 2^61 - 1, for an n x m matrix M.
+ * Column sums are kept exactly in 128 bits and reduced once at the end;
+ * rows with s[i] == 0 are skipped.
+ * @return A 1 x m vector with entries in [0, p).
+ */
+ModVector vectorMatrixMultiplyMod61(const ModVector& s, const Matrix& M) {
+    std::vector<__int128> sums(M.cols(), 0);
+    for (std::size_t i = 0; i < M.rows(); ++i) {
+        if (s[i] == 0) continue;
+        const int* row = M.row(i);
+        std::int64_t si = static_cast<std::int64_t>(s[i]);
+        for (std::size_t j = 0; j < M.cols(); ++j) {
+            sums[j] += static_cast<__int128>(row[j]) * si;
+        }
+    }
+    ModVector result(M.cols());
+    for (std::size_t j = 0; j < M.cols(); ++j) {
+        std::uint64_t r = reduceMod61(static_cast<unsigned __int128>(sums[j] < 0 ? -sums[j] : sums[j]));
+        result[j] = (sums[j] < 0 && r != 0) ? kMersenne61 - r : r;
+    }
+    return result;
+}
+
+/**
+ * @brief Where C differs from A * B, as found by freivaldsLocalizeErrors.
+ */
+struct FreivaldsFaults {
+    std::vector<std::size_t> rows;  // Rows of C containing at least one wrong entry
+    std::vector<std::size_t> cols;  // Columns of C containing at least one wrong entry
+    // Individual wrong entries (i, j); only filled in when entriesResolved
+    std::vector<std::pair<std::size_t, std::size_t>> entries;
+    bool entriesResolved = false;
+};
+
+/**
+ * @brief Locates the wrong entries of C after a failed Freivalds check.
+ *
+ * Let D = A * B - C. One projection D * r over Z_p (p = 2^61 - 1) is
+ * nonzero exactly in the faulty rows, and one projection s^T * D is
+ * nonzero exactly in the faulty columns, each missing a given faulty
+ * row/column with probability <= 1/p. Both cost O(nm + mp + np).
+ *
+ * If the errors are sparse, i.e. checking every (faulty row, faulty
+ * column) pair directly costs no more than the projections did, each
+ * candidate is recomputed exactly in O(m) and entries lists the ones that
+ * are really wrong. Otherwise entriesResolved is false and the caller can
+ * recompute just the reported rows or columns.
+ */
+FreivaldsFaults freivaldsLocalizeErrors(const Matrix& A, const Matrix& B, const Matrix& C) {
+    FreivaldsFaults faults;
+    if (!productShapesMatch(A, B, C)) {
+        return faults; // Invalid dimensions
+    }
+    std::size_t n = A.rows();
+    std::size_t m = B.rows();
+    std::size_t p = B.cols();
+
+    // 1. Random vectors r (p x 1) and s (n x 1) with entries from Z_p
+    std::mt19937_64 generator = seededGenerator();
+    std::uniform_int_distribution<std::uint64_t> distribution(0, kMersenne61 - 1);
+    ModVector r(p), s(n);
+    for (auto& value : r) value = distribution(generator);
+    for (auto& value : s) value = distribution(generator);
+
+    // 2. Faulty rows: entries where A(Br) != Cr  (O(nm + mp + np))
+    ModVector A_Br = matrixVectorMultiplyMod61(A, matrixVectorMultiplyMod61(B, r));
+    ModVector Cr = matrixVectorMultiplyMod61(C, r);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (A_Br[i] != Cr[i]) faults.rows.push_back(i);
+    }
+    if (faults.rows.empty()) {
+        faults.entriesResolved = true; // Nothing to localize
+        return faults;
+    }
+
+    // 3. Faulty columns: entries where (s^T A)B != s^T C  (O(nm + mp + np))
+    ModVector sA_B = vectorMatrixMultiplyMod61(vectorMatrixMultiplyMod61(s, A), B);
+    ModVector sC = vectorMatrixMultiplyMod61(s, C);
+    for (std::size_t j = 0; j < p; ++j) {
+        if (sA_B[j] != sC[j]) faults.cols.push_back(j);
+    }
+
+    // 4. For sparse error patterns, check each candidate entry exactly
+    std::size_t budget = (n * m + m * p + n * p) / m;
+    if (faults.rows.size() * faults.cols.size() > budget) {
+        return faults; // Dense errors: report rows and columns only
+    }
+    for (std::size_t i : faults.rows) {
+        const int* a = A.row(i);
+        for (std::size_t j : faults.cols) {
+            __int128 exact = 0;
+            for (std::size_t k = 0; k < m; ++k) {
+                exact += static_cast<std::int64_t>(a[k]) * B(k, j);
+            }
+            if (exact != C(i, j)) faults.entries.emplace_back(i, j);
+        }
+    }
+    faults.entriesResolved = true;
+    return faults;
+}
+
+// --- Online verification of tiled outputs ---
+
+/**
+ * @brief Verifies C = A * B incrementally while C is produced tile by tile.
+ *
+ * The random vector r is fixed up front and A * (B * r) is precomputed
+ * over Z_p (p = 2^61 - 1). Each arriving tile of C is folded into C * r,
+ * and once every tile of a band of rows has arrived that band is compared
+ * and reported through the callback, so verification overlaps with
+ * production. Tiles must not overlap, may arrive in any order, and
+ * addTile may be called from several producer threads at once.
+ */
+class TileStreamVerifier {
+public:
+    // Called once per band with its index and whether it passed
+    using BandCallback = std::function<void(std::size_t band, bool passed)>;
+
+    TileStreamVerifier(const Matrix& A, const Matrix& B, std::size_t bandRows, BandCallback onBandComplete)
+        : rows_(A.rows()), cols_(B.cols()), bandRows_(std::max<std::size_t>(bandRows, 1)),
+          onBandComplete_(std::move(onBandComplete)) {
+        if (A.cols() != B.rows()) {
+            rows_ = cols_ = 0; // Invalid dimensions: every tile is rejected
+            return;
+        }
+
+        // 1. Fix r with entries from Z_p and precompute A * (B * r)
+        std::mt19937_64 generator = seededGenerator();
+        std::uniform_int_distribution<std::uint64_t> distribution(0, kMersenne61 - 1);
+        r_.resize(cols_);
+        for (auto& value : r_) value = distribution(generator);
+        expected_ = matrixVectorMultiplyMod61(A, matrixVectorMultiplyMod61(B, r_));
+
+        // 2. C * r starts at zero and no band has seen any entries yet
+        accumulated_.assign(rows_, 0);
+        received_.assign(bandCount(), 0);
+        passed_.assign(bandCount(), false);
+    }
+
+    std::size_t bandCount() const { return (rows_ + bandRows_ - 1) / bandRows_; }
+
+    /**
+     * @brief Folds the tile whose top-left corner is C(row, col) into C * r.
+     * @return false if the tile does not fit inside C.
+     */
+    bool addTile(std::size_t row, std::size_t col, const Matrix& tile) {
+        if (row + tile.rows() > rows_ || col + tile.cols() > cols_) {
+            return false;
+        }
+
+        // 1. Partial dot products of the tile rows (outside the lock)
+        ModVector partial(tile.rows());
+        for (std::size_t i = 0; i < tile.rows(); ++i) {
+            partial[i] = dotProductMod61(tile.row(i), r_.data() + col, tile.cols());
+        }
+
+        // 2. Accumulate and collect the bands this tile completed
+        std::vector<std::pair<std::size_t, bool>> finished;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (std::size_t i = 0; i < tile.rows(); ++i) {
+                std::uint64_t sum = accumulated_[row + i] + partial[i];
+                accumulated_[row + i] = sum >= kMersenne61 ? sum - kMersenne61 : sum;
+            }
+            for (std::size_t i = row; i < row + tile.rows();) {
+                std::size_t band = i / bandRows_;
+                std::size_t bandEnd = std::min(rows_, (band + 1) * bandRows_);
+                std::size_t height = std::min(bandEnd, row + tile.rows()) - i;
+                received_[band] += height * tile.cols();
+                if (received_[band] == (bandEnd - band * bandRows_) * cols_) {
+                    passed_[band] = std::equal(expected_.begin() + band * bandRows_, expected_.begin() + bandEnd,
+                                               accumulated_.begin() + band * bandRows_);
+                    finished.emplace_back(band, passed_[band]);
+                }
+                i = bandEnd;
+            }
+        }
+
+        // 3. Report outside the lock so the callback may add more tiles
+        if (onBandComplete_) {
+            for (const auto& result : finished) onBandComplete_(result.first, result.second);
+        }
+        return true;
+    }
+
+    // true once every band has been received and passed
+    bool allPassed() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return rows_ != 0 && std::all_of(passed_.begin(), passed_.end(), [](bool ok) { return ok; });
+    }
+
+private:
+    std::size_t rows_;
+    std::size_t cols_;
+    std::size_t bandRows_;
+    BandCallback onBandComplete_;
+    ModVector r_;
+    ModVector expected_;                 // A * (B * r) mod p
+    ModVector accumulated_;              // C * r mod p over the tiles seen so far
+    std::vector<std::size_t> received_;  // Entries of C received per band
+    std::vector<bool> passed_;
+    mutable std::mutex mutex_;
+};
+
+// --- Multithreaded verification ---
+
+/**
+ * @brief Splits [0, count) into numThreads contiguous slices and runs
+ * fn(begin, end) on each in parallel. Returns once every slice is done,
+ * so consecutive calls are separated by a barrier.
+ */
+template <typename Fn>
+void parallelForRows(std::size_t count, unsigned numThreads, Fn fn) {
+    if (numThreads == 0) numThreads = 1;
+    if (numThreads > count) numThreads = static_cast<unsigned>(count == 0 ? 1 : count);
+    if (numThreads == 1) {
+        fn(std::size_t{0}, count);
+        return;
+    }
+
+    std::size_t chunk = (count + numThreads - 1) / numThreads;
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads - 1);
+    for (unsigned t = 1; t < numThreads; ++t) {
+        std::size_t begin = std::min(count, t * chunk);
+        std::size_t end = std::min(count, begin + chunk);
+        workers.emplace_back(fn, begin, end);
+    }
+    fn(std::size_t{0}, std::min(count, chunk)); // The calling thread takes the first slice
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Freivalds' technique (single iteration) with rows split across threads.
+ *
+ * Phase 1 computes B * r, phase 2 runs the fused row check of A * (B * r)
+ * against C * r. Phase 2 reads all of B * r, so the only synchronization
+ * is the barrier between the two phases. A mismatch in one band stops the
+ * other threads early.
+ * @param numThreads Number of threads to use (0 = hardware concurrency).
+ * @return true if A(Br) == Cr, false otherwise.
+ */
+bool freivaldsVerifyParallel(const Matrix& A, const Matrix& B, const Matrix& C, unsigned numThreads = 0) {
+    if (!productShapesMatch(A, B, C)) {
+        return false; // Invalid dimensions
+    }
+    std::size_t n = A.rows();
+    std::size_t m = B.rows();
+    std::size_t p = B.cols();
+    if (numThreads == 0) numThreads = std::thread::hardware_concurrency();
+
+    // 1. Generate random p x 1 vector r with {0, 1} entries as a bitmask
+    std::mt19937_64 generator = seededGenerator();
+    BitVector r = randomBitVector(p, generator);
+
+    // 2. Phase 1: B * r, each thread owning a band of rows
+    Vector Br(m);
+    parallelForRows(m, numThreads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            Br[i] = maskedRowSumInt32(B.row(i), r.words.data(), p);
+        }
+    });
+
+    // 3. Phase 2: fused check of A * (B * r) against C * r band by band
+    std::atomic<bool> equal{true};
+    parallelForRows(n, numThreads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!equal.load(std::memory_order_relaxed)) return; // Another band already failed
+            if (!rowsAgree(A, Br, C, r, i, i + 1)) {
+                equal.store(false, std::memory_order_relaxed);
+                return;
+            }
+        }
+    });
+    return equal.load();
+}
+
+// --- Out-of-core verification over memory-mapped files (POSIX) ---
+//
+// File layout: a 64-byte MatrixFileHeader followed by rows * cols native
+// 32-bit ints, row after row with no padding. Only row 0 starts on a
+// cache line; the kernels use unaligned loads, so the other rows need not.
+
+struct MatrixFileHeader {
+    char magic[8];              // "FRVMAT1"
+    std::uint64_t rows;
+    std::uint64_t cols;
+    std::uint32_t elementBytes; // sizeof(int)
+    std::uint32_t reserved[9];
+};
+static_assert(sizeof(MatrixFileHeader) == 64, "header must keep row 0 cache-line aligned");
+
+constexpr char kMatrixFileMagic[8] = {'F', 'R', 'V', 'M', 'A', 'T', '1', '\0'};
+
+// Rows are streamed through the kernels in blocks of about this many bytes
+constexpr std::size_t kStreamBlockBytes = 64 * 1024 * 1024;
+
+/**
+ * @brief Writes M to path in the binary layout read by MappedMatrix.
+ * @return true on success, false if the file could not be written.
+ */
+bool writeMatrixFile(const std::string& path, const Matrix& M) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    MatrixFileHeader header{};
+    std::memcpy(header.magic, kMatrixFileMagic, sizeof(header.magic));
+    header.rows = M.rows();
+    header.cols = M.cols();
+    header.elementBytes = sizeof(int);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (std::size_t i = 0; i < M.rows(); ++i) {
+        out.write(reinterpret_cast<const char*>(M.row(i)), M.cols() * sizeof(int));
+    }
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Read-only, memory-mapped view of a matrix file.
+ *
+ * Nothing is copied into user memory: row(i) points straight into the
+ * mapping, and callers use prefetchRows/releaseRows to keep only the row
+ * block being processed resident.
+ */
+class MappedMatrix {
+public:
+    MappedMatrix() = default;
+    MappedMatrix(const MappedMatrix&) = delete;
+    MappedMatrix& operator=(const MappedMatrix&) = delete;
+    ~MappedMatrix() { close(); }
+
+    /**
+     * @brief Maps the file at path.
+     * @return false if the file is missing, malformed or cannot be mapped.
+     */
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(MatrixFileHeader)) {
+            ::close(fd);
+            return false;
+        }
+        void* base = ::mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd); // The mapping keeps the file alive
+        if (base == MAP_FAILED) return false;
+        base_ = static_cast<const char*>(base);
+        length_ = info.st_size;
+
+        MatrixFileHeader header;
+        std::memcpy(&header, base_, sizeof(header));
+        if (std::memcmp(header.magic, kMatrixFileMagic, sizeof(header.magic)) != 0 ||
+            header.elementBytes != sizeof(int) ||
+            (length_ - sizeof(header)) / sizeof(int) / std::max<std::uint64_t>(header.cols, 1) < header.rows) {
+            close();
+            return false;
+        }
+        rows_ = header.rows;
+        cols_ = header.cols;
+        ::madvise(const_cast<char*>(base_), length_, MADV_SEQUENTIAL);
+        return true;
+    }
+
+    void close() {
+        if (base_ != nullptr) ::munmap(const_cast<char*>(base_), length_);
+        base_ = nullptr;
+        length_ = rows_ = cols_ = 0;
+    }
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    const int* row(std::size_t i) const {
+        return reinterpret_cast<const int*>(base_ + sizeof(MatrixFileHeader)) + i * cols_;
+    }
+
+    // Readahead hint for rows [begin, end)
+    void prefetchRows(std::size_t begin, std::size_t end) const { advise(begin, end, MADV_WILLNEED); }
+    // Lets the kernel reclaim rows [begin, end) once they have been consumed
+    void releaseRows(std::size_t begin, std::size_t end) const { advise(begin, end, MADV_DONTNEED); }
+
+private:
+    void advise(std::size_t begin, std::size_t end, int advice) const {
+        if (begin >= end) return;
+        const std::uintptr_t page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+        std::uintptr_t first = reinterpret_cast<std::uintptr_t>(row(begin)) & ~(page - 1);
+        std::uintptr_t last = reinterpret_cast<std::uintptr_t>(row(end));
+        if (advice == MADV_DONTNEED) {
+            // The page holding row(end) also holds the next block, which may
+            // already be prefetched: release it with the next block instead
+            last &= ~(page - 1);
+            if (last <= first) return;
+        }
+        ::madvise(reinterpret_cast<void*>(first), last - first, advice);
+    }
+
+    const char* base_ = nullptr;
+    std::size_t length_ = 0;
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+};
+
+/**
+ * @brief Verifies A * B = C for matrices stored in files (single iteration).
+ *
+ * The matrices are memory-mapped and streamed through the dot-product
+ * kernels one row block at a time, with readahead for the next block and
+ * release of the previous one, so memory use stays at O(m + p) no matter
+ * how large the files are.
+ * @return true if A(Br) == Cr, false otherwise (including unreadable files).
+ */
+bool freivaldsVerifyFiles(const std::string& pathA, const std::string& pathB, const std::string& pathC) {
+    MappedMatrix A, B, C;
+    if (!A.open(pathA) || !B.open(pathB) || !C.open(pathC)) {
+        return false; // Missing or malformed input
+    }
+    if (!productShapesMatch(A, B, C)) {
+        return false; // Invalid dimensions
+    }
+    std::size_t n = A.rows();
+    std::size_t m = B.rows();
+    std::size_t p = B.cols();
+
+    // 1. Generate random p x 1 vector r with {0, 1} entries as a bitmask
+    std::mt19937_64 generator = seededGenerator();
+    BitVector r = randomBitVector(p, generator);
+
+    // 2. Stream B block by block to compute B * r
+    Vector Br(m);
+    std::size_t blockRows = std::max<std::size_t>(kStreamBlockBytes / (p * sizeof(int)), 1);
+    for (std::size_t begin = 0; begin < m; begin += blockRows) {
+        std::size_t end = std::min(m, begin + blockRows);
+        B.prefetchRows(end, std::min(m, end + blockRows));
+        for (std::size_t i = begin; i < end; ++i) {
+            Br[i] = maskedRowSumInt32(B.row(i), r.words.data(), p);
+        }
+        B.releaseRows(begin, end);
+    }
+
+    // 3. Stream A and C together through the fused row check
+    blockRows = std::max<std::size_t>(kStreamBlockBytes / ((m + p) * sizeof(int)), 1);
+    for (std::size_t begin = 0; begin < n; begin += blockRows) {
+        std::size_t end = std::min(n, begin + blockRows);
+        A.prefetchRows(end, std::min(n, end + blockRows));
+        C.prefetchRows(end, std::min(n, end + blockRows));
+        for (std::size_t i = begin; i < end; ++i) {
+            if (dotProduct(A.row(i), Br.data(), m) != maskedRowSumInt32(C.row(i), r.words.data(), p)) {
+                return false;
+            }
+        }
+        A.releaseRows(begin, end);
+        C.releaseRows(begin, end);
+    }
+    return true;
+}
+
+// --- Sparse operands (CSR / CSC) ---
+
+/**
+ * @brief Compressed sparse row matrix: the nonzeros of row i are
+ * values[rowPtr[i] .. rowPtr[i + 1]) in columns colIdx[...].
+ */
+struct CsrMatrix {
+    std::size_t numRows = 0;
+    std::size_t numCols = 0;
+    std::vector<std::size_t> rowPtr{0};
+    std::vector<std::size_t> colIdx;
+    std::vector<int> values;
+
+    std::size_t rows() const { return numRows; }
+    std::size_t cols() const { return numCols; }
+    std::size_t nonZeros() const { return values.size(); }
+
+    static CsrMatrix fromDense(const Matrix& M) {
+        CsrMatrix S;
+        S.numRows = M.rows();
+        S.numCols = M.cols();
+        for (std::size_t i = 0; i < M.rows(); ++i) {
+            for (std::size_t j = 0; j < M.cols(); ++j) {
+                if (M(i, j) != 0) {
+                    S.colIdx.push_back(j);
+                    S.values.push_back(M(i, j));
+                }
+            }
+            S.rowPtr.push_back(S.values.size());
+        }
+        return S;
+    }
+};
+
+/**
+ * @brief Compressed sparse column matrix: the nonzeros of column j are
+ * values[colPtr[j] .. colPtr[j + 1]) in rows rowIdx[...].
+ */
+struct CscMatrix {
+    std::size_t numRows = 0;
+    std::size_t numCols = 0;
+    std::vector<std::size_t> colPtr{0};
+    std::vector<std::size_t> rowIdx;
+    std::vector<int> values;
+
+    std::size_t rows() const { return numRows; }
+    std::size_t cols() const { return numCols; }
+    std::size_t nonZeros() const { return values.size(); }
+
+    static CscMatrix fromDense(const Matrix& M) {
+        CscMatrix S;
+        S.numRows = M.rows();
+        S.numCols = M.cols();
+        for (std::size_t j = 0; j < M.cols(); ++j) {
+            for (std::size_t i = 0; i < M.rows(); ++i) {
+                if (M(i, j) != 0) {
+                    S.rowIdx.push_back(i);
+                    S.values.push_back(M(i, j));
+                }
+            }
+            S.colPtr.push_back(S.values.size());
+        }
+        return S;
+    }
+};
+
+/**
+ * @brief Multiplies a CSR matrix by a vector in O(nnz + rows).
+ * Arithmetic wraps modulo 2^32, matching the dense kernels.
+ */
+Vector matrixVectorMultiply(const CsrMatrix& M, const Vector& x) {
+    Vector result(M.rows(), 0);
+    for (std::size_t i = 0; i < M.rows(); ++i) {
+        std::uint32_t sum = 0;
+        for (std::size_t k = M.rowPtr[i]; k < M.rowPtr[i + 1]; ++k) {
+            sum += static_cast<std::uint32_t>(M.values[k]) * static_cast<std::uint32_t>(x[M.colIdx[k]]);
+        }
+        result[i] = static_cast<int>(sum);
+    }
+    return result;
+}
+
+/**
+ * @brief Multiplies a CSC matrix by a vector in O(nnz + cols).
+ * Columns whose x entry is zero are skipped, which halves the work on
+ * average for a random {0, 1} vector.
+ */
+Vector matrixVectorMultiply(const CscMatrix& M, const Vector& x) {
+    std::vector<std::uint32_t> sums(M.rows(), 0);
+    for (std::size_t j = 0; j < M.cols(); ++j) {
+        if (x[j] == 0) continue;
+        std::uint32_t xj = static_cast<std::uint32_t>(x[j]);
+        for (std::size_t k = M.colPtr[j]; k < M.colPtr[j + 1]; ++k) {
+            sums[M.rowIdx[k]] += static_cast<std::uint32_t>(M.values[k]) * xj;
+        }
+    }
+    return Vector(sums.begin(), sums.end());
+}
+
+template <typename T> class MatrixView;
+
+/**
+ * @brief Whether an operand type has integer entries. The format-generic
+ * verifiers below use an int random vector and compare exactly, which is
+ * only sound for integers; floating-point matrices and views go through
+ * the typed overloads instead.
+ */
+template <typename M> constexpr bool hasIntegerEntries = true; // Matrix, CsrMatrix, CscMatrix
+template <typename T> constexpr bool hasIntegerEntries<BasicMatrix<T>> = std::is_integral_v<T>;
+template <typename T> constexpr bool hasIntegerEntries<MatrixView<T>> = std::is_integral_v<T>;
+
+/**
+ * @brief Freivalds' technique for any mix of Matrix, CsrMatrix,
+ * CscMatrix and integer MatrixView operands (single iteration).
+ *
+ * Each product is evaluated by the matrixVectorMultiply overload for its
+ * storage format, so the cost is O(nnz(A) + nnz(B) + nnz(C) + n + p) with
+ * sparse operands and O(rows x cols) only for the dense ones. Views are
+ * read in place in their own layout.
+ * @return true if A(Br) == Cr, false otherwise.
+ */
+template <typename MA, typename MB, typename MC>
+bool freivaldsVerify(const MA& A, const MB& B, const MC& C) {
+    static_assert(hasIntegerEntries<MA> && hasIntegerEntries<MB> && hasIntegerEntries<MC>,
+                  "floating-point operands must all be BasicMatrix or all be MatrixView");
+    if (!productShapesMatch(A, B, C)) {
+        return false; // Invalid dimensions
+    }
+    std::size_t p = B.cols();
+
+    // 1. Generate random p x 1 vector r with {0, 1} entries (expanded, since
+    //    sparse kernels gather r at arbitrary column indices)
+    std::mt19937_64 generator = seededGenerator();
+    Vector r = expandBits<int>(randomBitVector(p, generator));
+
+    // 2. Compute A * (B * r) and C * r with the format-specific kernels
+    Vector A_Br = matrixVectorMultiply(A, matrixVectorMultiply(B, r));
+    Vector Cr = matrixVectorMultiply(C, r);
+
+    // 3. Compare  (O(n))
+    return A_Br == Cr;
+}
+
+// --- Matrix chains A1 * A2 * ... * Ak ---
+
+/**
+ * @brief Multiplies the transpose of a dense matrix by a vector without
+ * forming the transpose: M^T x is the row combination x^T M.
+ */
+template <typename T, typename Acc>
+std::vector<Acc> transposeVectorMultiply(const BasicMatrix<T>& M, const std::vector<Acc>& x) {
+    return vectorMatrixMultiply(x, M);
+}
+
+/**
+ * @brief Multiplies the transpose of a CSR matrix by a vector in
+ * O(nnz + rows): the rows of M are the columns of M^T, so this scatters
+ * like the CSC kernel and skips rows whose x entry is zero.
+ */
+Vector transposeVectorMultiply(const CsrMatrix& M, const Vector& x) {
+    std::vector<std::uint32_t> sums(M.cols(), 0);
+    for (std::size_t i = 0; i < M.rows(); ++i) {
+        if (x[i] == 0) continue;
+        std::uint32_t xi = static_cast<std::uint32_t>(x[i]);
+        for (std::size_t k = M.rowPtr[i]; k < M.rowPtr[i + 1]; ++k) {
+            sums[M.colIdx[k]] += static_cast<std::uint32_t>(M.values[k]) * xi;
+        }
+    }
+    return Vector(sums.begin(), sums.end());
+}
+
+/**
+ * @brief Multiplies the transpose of a CSC matrix by a vector in
+ * O(nnz + cols): each column of M is a row of M^T, read as a gather.
+ */
+Vector transposeVectorMultiply(const CscMatrix& M, const Vector& x) {
+    Vector result(M.cols(), 0);
+    for (std::size_t j = 0; j < M.cols(); ++j) {
+        std::uint32_t sum = 0;
+        for (std::size_t k = M.colPtr[j]; k < M.colPtr[j + 1]; ++k) {
+            sum += static_cast<std::uint32_t>(M.values[k]) * static_cast<std::uint32_t>(x[M.rowIdx[k]]);
+        }
+        result[j] = static_cast<int>(sum);
+    }
+    return result;
+}
+
+/**
+ * @brief One factor of a chain: a matrix used as is or as its transpose.
+ * The factor only points at the matrix, which must outlive the check, so
+ * temporaries are rejected. MatrixView factors hold the view by value.
+ */
+template <typename M>
+struct ChainFactor {
+    const M* matrix = nullptr;
+    bool transposed = false;
+
+    std::size_t rows() const { return transposed ? matrix->cols() : matrix->rows(); }
+    std::size_t cols() const { return transposed ? matrix->rows() : matrix->cols(); }
+};
+
+template <typename M>
+ChainFactor<M> asFactor(const M& matrix) { return {&matrix, false}; }
+
+template <typename M>
+ChainFactor<M> asTransposedFactor(const M& matrix) { return {&matrix, true}; }
+
+template <typename M>
+ChainFactor<M> asFactor(const M&& matrix) = delete;
+
+template <typename M>
+ChainFactor<M> asTransposedFactor(const M&& matrix) = delete;
+
+/**
+ * @brief Checks that the chain is nonempty, adjacent factors conform and
+ * the product has the shape of C, with no dimension equal to zero.
+ */
+template <typename M, typename MC>
+bool chainShapesMatch(const std::vector<ChainFactor<M>>& factors, const MC& C) {
+    if (factors.empty() || C.rows() == 0 || C.cols() == 0 ||
+        factors.front().rows() != C.rows() || factors.back().cols() != C.cols()) {
+        return false;
+    }
+    for (std::size_t i = 0; i + 1 < factors.size(); ++i) {
+        if (factors[i].cols() != factors[i + 1].rows()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Verifies if A1 * A2 * ... * Ak = C using Freivalds' technique
+ * (single iteration), without forming any intermediate product.
+ *
+ * A single random {0, 1} vector r is pushed right to left through the
+ * factors, x <- Ai x for i = k .. 1, and compared with Cr. Transposed
+ * factors use transposeVectorMultiply, so the total cost is one
+ * matrix-vector product per factor: O(sum of nnz) for sparse factors and
+ * O(rows x cols) for dense ones. A wrong C is accepted with probability
+ * at most 1/2.
+ * @return true if A1(A2(...(Ak r))) == Cr, false otherwise.
  */
+template <typename M, typename MC>
+bool freivaldsVerifyChain(const std::vector<ChainFactor<M>>& factors, const MC& C) {
+    static_assert(hasIntegerEntries<M> && hasIntegerEntries<MC>,
+                  "floating-point chains must be given as MatrixView factors");
+    if (!chainShapesMatch(factors, C)) {
+        return false; // Invalid dimensions
+    }
 
-#include <iostream>
-#include <vector>
-#include <random>       // For std::mt19937
-#include <chrono>       // For seeding the random generator
+    // 1. Generate random p x 1 vector r with {0, 1} entries
+    std::mt19937_64 generator = seededGenerator();
+    Vector r = expandBits<int>(randomBitVector(C.cols(), generator));
 
-// Define a Matrix as a 2D vector
-using Matrix = std::vector<std::vector<int>>;
-// Define a Vector as a 1D vector
-using Vector = std::vector<int>;
+    // 2. Push r through the chain from right to left  (one product per factor)
+    Vector x = r;
+    for (std::size_t i = factors.size(); i-- > 0;) {
+        const ChainFactor<M>& factor = factors[i];
+        x = factor.transposed ? transposeVectorMultiply(*factor.matrix, x)
+                              : matrixVectorMultiply(*factor.matrix, x);
+    }
+
+    // 3. Compare with C * r  (O(np))
+    return x == matrixVectorMultiply(C, r);
+}
+
+// --- Bit-packed matrices over GF(2) ---
 
 /**
- * @brief Multiplies an n x n matrix by an n x 1 vector.
- * @return An n x 1 vector (the result).
+ * @brief A matrix over GF(2) with 64 entries per word: entry (i, j) is
+ * bit j % 64 of row(i)[j / 64]. Rows are padded to a cache line and the
+ * padding bits are kept zero, so a 100000 x 100000 matrix takes 1.25 GB
+ * instead of 40 GB as a Matrix.
  */
-Vector matrixVectorMultiply(const Matrix& M, const Vector& r) {
-    int n = M.size();
-    Vector result(n, 0);
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            result[i] += M[i][j] * r[j];
+class BitMatrix {
+public:
+    BitMatrix() = default;
+
+    BitMatrix(std::size_t rows, std::size_t cols)
+        : rows_(rows), cols_(cols), stride_(paddedStride(cols)), data_(rows * stride_, 0) {}
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    // Distance in words between the starts of consecutive rows
+    std::size_t stride() const { return stride_; }
+
+    std::uint64_t* row(std::size_t i) { return data_.data() + i * stride_; }
+    const std::uint64_t* row(std::size_t i) const { return data_.data() + i * stride_; }
+
+    bool get(std::size_t i, std::size_t j) const { return (row(i)[j >> 6] >> (j & 63)) & 1; }
+
+    void set(std::size_t i, std::size_t j, bool value) {
+        std::uint64_t bit = 1ULL << (j & 63);
+        if (value) {
+            row(i)[j >> 6] |= bit;
+        } else {
+            row(i)[j >> 6] &= ~bit;
+        }
+    }
+
+    // Packs a 0/1 matrix; any nonzero entry becomes 1
+    static BitMatrix fromDense(const Matrix& M) {
+        BitMatrix bits(M.rows(), M.cols());
+        for (std::size_t i = 0; i < M.rows(); ++i) {
+            for (std::size_t j = 0; j < M.cols(); ++j) {
+                if (M(i, j) != 0) bits.set(i, j, true);
+            }
         }
+        return bits;
+    }
+
+private:
+    static std::size_t paddedStride(std::size_t cols) {
+        const std::size_t perLine = kAlignment / sizeof(std::uint64_t);
+        std::size_t words = (cols + 63) / 64;
+        return (words + perLine - 1) / perLine * perLine;
+    }
+
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    std::size_t stride_ = 0;
+    std::vector<std::uint64_t, AlignedAllocator<std::uint64_t>> data_;
+};
+
+/**
+ * @brief Inner product of two packed GF(2) vectors: the parity of
+ * popcount(a AND x). The AND-ed words are XOR-folded into one word first,
+ * so the whole product costs a single popcount.
+ */
+inline bool parityDot(const std::uint64_t* a, const std::uint64_t* x, std::size_t words) {
+    std::size_t j = 0;
+    std::uint64_t fold = 0;
+#if defined(__AVX512F__)
+    __m512i acc = _mm512_setzero_si512();
+    for (; j + 8 <= words; j += 8) {
+        acc = _mm512_ternarylogic_epi64(acc, _mm512_loadu_si512(a + j), _mm512_loadu_si512(x + j), 0x78); // acc ^ (a & x)
+    }
+    alignas(64) std::uint64_t lanes[8];
+    _mm512_store_si512(lanes, acc);
+    for (std::uint64_t lane : lanes) fold ^= lane;
+#elif defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+    for (; j + 4 <= words; j += 4) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + j));
+        __m256i vx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + j));
+        acc = _mm256_xor_si256(acc, _mm256_and_si256(va, vx));
+    }
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    for (std::uint64_t lane : lanes) fold ^= lane;
+#endif
+    for (; j < words; ++j) {
+        fold ^= a[j] & x[j];
+    }
+    return __builtin_popcountll(fold) & 1;
+}
+
+/**
+ * @brief Computes M * x over GF(2) for a packed vector x.
+ * @return The packed result, one bit per row of M.
+ */
+BitVector matrixVectorMultiplyGF2(const BitMatrix& M, const BitVector& x) {
+    BitVector result;
+    result.size = M.rows();
+    result.words.assign((M.rows() + 63) / 64, 0);
+    std::size_t words = (M.cols() + 63) / 64;
+    for (std::size_t i = 0; i < M.rows(); ++i) {
+        result.words[i >> 6] |= static_cast<std::uint64_t>(parityDot(M.row(i), x.words.data(), words)) << (i & 63);
     }
     return result;
 }
 
 /**
- * @brief Verifies if A * B = C using Freivalds' technique (single iteration).
- * @return true if A(Br) == Cr, false otherwise.
+ * @brief Verifies if A * B = C over GF(2) (single iteration).
+ *
+ * Entries are bits and the product is XOR of ANDs. r is a random vector
+ * in GF(2)^p and each matrix-vector product is one AND + popcount-parity
+ * pass over the packed rows, O((nm + mp + np) / 64) word operations.
+ * A wrong C is accepted with probability at most 1/2.
+ *
+ * This checks products over GF(2). A Boolean (OR of ANDs) product is not
+ * a ring product and cannot be checked this way directly: verify the
+ * integer counts AB with a Matrix instead and threshold them.
+ * @return true if A(Br) == Cr over GF(2), false otherwise.
  */
-bool freivaldsVerify(const Matrix& A, const Matrix& B, const Matrix& C) {
-    int n = A.size();
-    if (n == 0 || A[0].size() != n || B.size() != n || B[0].size() != n || C.size() != n || C[0].size() != n) {
+bool freivaldsVerifyGF2(const BitMatrix& A, const BitMatrix& B, const BitMatrix& C) {
+    if (!productShapesMatch(A, B, C)) {
         return false; // Invalid dimensions
     }
 
-    // 1. Set up a high-quality random number generator
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    std::mt19937 generator(seed);
-    std::uniform_int_distribution<int> distribution(0, 1);
+    // 1. Generate random p x 1 vector r over GF(2)
+    std::mt19937_64 generator = seededGenerator();
+    BitVector r = randomBitVector(B.cols(), generator);
 
-    // 2. Generate random n x 1 vector r with {0, 1} entries
-    Vector r(n);
-    for (int i = 0; i < n; ++i) {
-        r[i] = distribution(generator);
+    // 2. Compute A * (B * r) and C * r  (one parity pass each)
+    BitVector A_Br = matrixVectorMultiplyGF2(A, matrixVectorMultiplyGF2(B, r));
+    BitVector Cr = matrixVectorMultiplyGF2(C, r);
+
+    // 3. Compare  (O(n / 64))
+    return A_Br.words == Cr.words;
+}
+
+/**
+ * @brief Computes M * R over GF(2) for a p x 64 panel R stored one word
+ * per row (bit t of R[j] is column t). Result word i is the XOR of the
+ * R[j] with M(i, j) = 1, so each set bit of M costs one XOR.
+ */
+std::vector<std::uint64_t> matrixPanelMultiplyGF2(const BitMatrix& M, const std::vector<std::uint64_t>& R) {
+    std::vector<std::uint64_t> result(M.rows(), 0);
+    std::size_t words = (M.cols() + 63) / 64;
+    for (std::size_t i = 0; i < M.rows(); ++i) {
+        const std::uint64_t* row = M.row(i);
+        std::uint64_t acc = 0;
+        for (std::size_t w = 0; w < words; ++w) {
+            for (std::uint64_t bits = row[w]; bits != 0; bits &= bits - 1) {
+                acc ^= R[w * 64 + __builtin_ctzll(bits)];
+            }
+        }
+        result[i] = acc;
+    }
+    return result;
+}
+
+/**
+ * @brief Verifies if A * B = C over GF(2) with 64 bit-sliced rounds.
+ *
+ * Draws 64 independent random vectors at once as a p x 64 panel R, one
+ * word per row, and checks A(BR) == CR with XOR-accumulate kernels. Each
+ * matrix is read once and the error probability drops to 2^-64. The cost
+ * is one XOR per set bit, so this pays off over 64 separate calls to
+ * freivaldsVerifyGF2 unless the matrices are very dense.
+ * @return true if all 64 rounds agree, false otherwise.
+ */
+bool freivaldsVerifyGF2Batch(const BitMatrix& A, const BitMatrix& B, const BitMatrix& C) {
+    if (!productShapesMatch(A, B, C)) {
+        return false; // Invalid dimensions
+    }
+    std::size_t p = B.cols();
+
+    // 1. Generate the random p x 64 panel R, one word per row
+    std::mt19937_64 generator = seededGenerator();
+    std::vector<std::uint64_t> R(p);
+    for (auto& word : R) {
+        word = generator();
     }
 
-    // 3. Compute v1 = B * r  (O(n^2))
-    Vector Br = matrixVectorMultiply(B, r);
-    
-    // 4. Compute v2 = A * (B * r)  (O(n^2))
-    Vector A_Br = matrixVectorMultiply(A, Br);
+    // 2. Compute A * (B * R) and C * R, 64 rounds per word
+    std::vector<std::uint64_t> A_BR = matrixPanelMultiplyGF2(A, matrixPanelMultiplyGF2(B, R));
+    std::vector<std::uint64_t> CR = matrixPanelMultiplyGF2(C, R);
 
-    // 5. Compute v3 = C * r  (O(n^2))
-    Vector Cr = matrixVectorMultiply(C, r);
+    // 3. Compare the two n x 64 panels
+    return A_BR == CR;
+}
 
-    // 6. Compare v2 and v3  (O(n))
-    return A_Br == Cr;
+// --- Certificates for factorizations and linear solves ---
+
+/**
+ * @brief Which part of a matrix a product reads. UnitLower reads the
+ * strict lower triangle and takes the diagonal to be 1, so L and U
+ * packed into one matrix (as getrf returns them) can be checked in place.
+ */
+enum class MatrixPart { Full, Lower, UnitLower, Upper };
+
+/**
+ * @brief Computes (M x, |M| xAbs) reading only the given part of M, so a
+ * triangular product skips the zero half and costs about half of a full one.
+ */
+template <typename T, typename Acc>
+std::pair<std::vector<Acc>, std::vector<Acc>> structuredMatrixVectorMultiply(
+        const BasicMatrix<T>& M, MatrixPart part, const std::vector<Acc>& x, const std::vector<Acc>& xAbs) {
+    std::size_t n = M.cols();
+    std::vector<Acc> result(M.rows(), 0), magnitude(M.rows(), 0);
+    for (std::size_t i = 0; i < M.rows(); ++i) {
+        std::size_t begin = part == MatrixPart::Upper ? std::min(i, n) : 0;
+        std::size_t end = n;
+        if (part == MatrixPart::Lower) end = std::min(i + 1, n);
+        if (part == MatrixPart::UnitLower) end = std::min(i, n);
+        std::tie(result[i], magnitude[i]) =
+            dotProductWithMagnitude(M.row(i) + begin, x.data() + begin, xAbs.data() + begin, end - begin);
+        if (part == MatrixPart::UnitLower && i < n) {
+            result[i] += x[i];
+            magnitude[i] += xAbs[i];
+        }
+    }
+    return {result, magnitude};
+}
+
+/**
+ * @brief Outcome of a certificate check. relativeResidual is the largest
+ * |lhs_i - rhs_i| / (|lhs|_i + |rhs|_i) over the rows of the projected
+ * check, i.e. the residual measured against the size of the terms that
+ * produced it; the check passes when it is within the tolerance.
+ */
+struct CertificateResult {
+    bool passed = false;
+    double residual = 0;         // max_i |lhs_i - rhs_i|
+    double relativeResidual = 0; // max_i |lhs_i - rhs_i| / (|lhs|_i + |rhs|_i)
+};
+
+/**
+ * @brief Compares two projections row by row against their magnitudes.
+ * Rows whose magnitude is zero must match exactly; NaNs always fail.
+ */
+inline CertificateResult compareProjections(const std::vector<double>& lhs, const std::vector<double>& lhsAbs,
+                                            const std::vector<double>& rhs, const std::vector<double>& rhsAbs,
+                                            double tolerance) {
+    auto keepWorst = [](double& worst, double value) {
+        if (std::isnan(value) || value > worst) worst = value; // NaN sticks once seen
+    };
+    CertificateResult result;
+    result.passed = true;
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        double residual = std::abs(lhs[i] - rhs[i]);
+        double scale = lhsAbs[i] + rhsAbs[i];
+        if (!(residual <= tolerance * scale)) {
+            result.passed = false; // Also rejects NaN
+        }
+        keepWorst(result.residual, residual);
+        keepWorst(result.relativeResidual, residual == 0 ? 0 : residual / scale);
+    }
+    return result;
+}
+
+/**
+ * @brief Default relative tolerance for certifying an order-n
+ * factorization computed in T: the backward error of the factorization
+ * (gamma_n in T) plus the rounding of the check itself (gamma_2n in double).
+ */
+template <typename T>
+double certificateTolerance(std::size_t n) {
+    return dotProductErrorBound<T>(n) + dotProductErrorBound<double>(2 * n);
+}
+
+/**
+ * @brief Draws a random {0, 1} vector as doubles; it is its own magnitude.
+ */
+inline std::vector<double> randomProjection(std::size_t n) {
+    std::mt19937_64 generator = seededGenerator();
+    return expandBits<double>(randomBitVector(n, generator));
+}
+
+/**
+ * @brief Certifies that X is an inverse of the n x n matrix A, A X = I,
+ * by comparing A(X r) with r in O(n^2).
+ * @param tolerance Relative tolerance; 0 selects certificateTolerance<T>(n).
+ */
+template <typename T>
+CertificateResult certifyInverse(const BasicMatrix<T>& A, const BasicMatrix<T>& X, double tolerance = 0) {
+    std::size_t n = A.rows();
+    if (n == 0 || A.cols() != n || X.rows() != n || X.cols() != n) {
+        return {}; // Invalid dimensions
+    }
+    if (tolerance == 0) tolerance = certificateTolerance<T>(n);
+
+    std::vector<double> r = randomProjection(n);
+    auto [Xr, XrAbs] = structuredMatrixVectorMultiply(X, MatrixPart::Full, r, r);
+    auto [A_Xr, A_XrAbs] = structuredMatrixVectorMultiply(A, MatrixPart::Full, Xr, XrAbs);
+    return compareProjections(A_Xr, A_XrAbs, r, r, tolerance);
+}
+
+/**
+ * @brief Certifies an LU factorization with row pivoting, L U = P A.
+ *
+ * L is unit lower triangular and U upper triangular; only those parts
+ * are read, so both may be the same packed matrix. Row i of P A is row
+ * perm[i] of A. Computes L(U r) with two triangular products and compares
+ * it with (A r)[perm[i]] in O(n^2), about half the work of dense products.
+ * @param tolerance Relative tolerance; 0 selects certificateTolerance<T>(n).
+ */
+template <typename T>
+CertificateResult certifyLU(const BasicMatrix<T>& L, const BasicMatrix<T>& U, const std::vector<std::size_t>& perm,
+                            const BasicMatrix<T>& A, double tolerance = 0) {
+    std::size_t n = A.rows();
+    if (n == 0 || A.cols() != n || L.rows() != n || L.cols() != n || U.rows() != n || U.cols() != n ||
+        perm.size() != n) {
+        return {}; // Invalid dimensions
+    }
+    std::vector<bool> seen(n, false);
+    for (std::size_t i : perm) {
+        if (i >= n || seen[i]) return {}; // Not a permutation
+        seen[i] = true;
+    }
+    if (tolerance == 0) tolerance = certificateTolerance<T>(n);
+
+    std::vector<double> r = randomProjection(n);
+    auto [Ur, UrAbs] = structuredMatrixVectorMultiply(U, MatrixPart::Upper, r, r);
+    auto [L_Ur, L_UrAbs] = structuredMatrixVectorMultiply(L, MatrixPart::UnitLower, Ur, UrAbs);
+    auto [Ar, ArAbs] = structuredMatrixVectorMultiply(A, MatrixPart::Full, r, r);
+    std::vector<double> PAr(n), PArAbs(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        PAr[i] = Ar[perm[i]];
+        PArAbs[i] = ArAbs[perm[i]];
+    }
+    return compareProjections(L_Ur, L_UrAbs, PAr, PArAbs, tolerance);
+}
+
+/**
+ * @brief Certifies a QR factorization Q R = A of an m x p matrix, with Q
+ * m x k and R k x p upper trapezoidal (only its upper part is read).
+ * Costs O(mk + kp + mp). This checks the product only; the orthogonality
+ * of Q is a separate property.
+ * @param tolerance Relative tolerance; 0 selects certificateTolerance<T>(m).
+ */
+template <typename T>
+CertificateResult certifyQR(const BasicMatrix<T>& Q, const BasicMatrix<T>& R, const BasicMatrix<T>& A,
+                            double tolerance = 0) {
+    if (!productShapesMatch(Q, R, A)) {
+        return {}; // Invalid dimensions
+    }
+    if (tolerance == 0) tolerance = certificateTolerance<T>(A.rows());
+
+    std::vector<double> r = randomProjection(A.cols());
+    auto [Rr, RrAbs] = structuredMatrixVectorMultiply(R, MatrixPart::Upper, r, r);
+    auto [Q_Rr, Q_RrAbs] = structuredMatrixVectorMultiply(Q, MatrixPart::Full, Rr, RrAbs);
+    auto [Ar, ArAbs] = structuredMatrixVectorMultiply(A, MatrixPart::Full, r, r);
+    return compareProjections(Q_Rr, Q_RrAbs, Ar, ArAbs, tolerance);
+}
+
+/**
+ * @brief Certifies a batch of k solutions of A x = b at once: A is n x n,
+ * the columns of X are the solutions and the columns of B the right-hand
+ * sides. Compares A(X r) with B r in O(n^2 + nk) instead of one residual
+ * per system.
+ * @param tolerance Relative tolerance; 0 selects certificateTolerance<T>(n).
+ */
+template <typename T>
+CertificateResult certifySolve(const BasicMatrix<T>& A, const BasicMatrix<T>& X, const BasicMatrix<T>& B,
+                               double tolerance = 0) {
+    if (A.rows() != A.cols() || !productShapesMatch(A, X, B)) {
+        return {}; // Invalid dimensions
+    }
+    if (tolerance == 0) tolerance = certificateTolerance<T>(A.rows());
+
+    std::vector<double> r = randomProjection(X.cols());
+    auto [Xr, XrAbs] = structuredMatrixVectorMultiply(X, MatrixPart::Full, r, r);
+    auto [A_Xr, A_XrAbs] = structuredMatrixVectorMultiply(A, MatrixPart::Full, Xr, XrAbs);
+    auto [Br, BrAbs] = structuredMatrixVectorMultiply(B, MatrixPart::Full, r, r);
+    return compareProjections(A_Xr, A_XrAbs, Br, BrAbs, tolerance);
+}
+
+// --- Asynchronous verification service ---
+
+/**
+ * @brief Runs freivaldsVerify jobs on a pool of worker threads.
+ *
+ * Producers submit (A, B, C) triples and get a std::future<bool> back,
+ * optionally with a callback that the worker invokes (and that must not
+ * throw) when the job finishes. Matrices are shared, not copied, so they
+ * stay alive until the job is done even if the producer lets go of them.
+ *
+ * The job queue is bounded: submit() blocks while it is full and
+ * trySubmit() refuses instead, so producers feel backpressure rather than
+ * growing the queue without limit. Callbacks run on the worker threads, so
+ * a callback that queues follow-up work must use trySubmit(): a blocking
+ * submit() from a callback deadlocks once every worker is waiting for room.
+ *
+ * A worker that takes a small job also takes the small jobs queued behind
+ * it (up to kMaxBatch). Jobs of the batch that pass the same A, B or C
+ * (the same shared_ptr target) are verified together: each job still gets
+ * its own random vector, but the products with a shared matrix come from
+ * one panel multiply, so that matrix is read once for the whole group.
+ * Jobs that share nothing, and large jobs, are run one at a time.
+ */
+class VerificationService {
+public:
+    using MatrixPtr = std::shared_ptr<const Matrix>;
+    using Callback = std::function<void(bool verified)>;
+
+    // Jobs with at most this many entries in A, B and C together are batched
+    static constexpr std::size_t kSmallJobEntries = 3 * 64 * 64;
+    static constexpr std::size_t kMaxBatch = 32;
+
+    explicit VerificationService(unsigned numThreads = 0, std::size_t queueCapacity = 1024)
+        : capacity_(std::max<std::size_t>(queueCapacity, 1)) {
+        if (numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned t = 0; t < numThreads; ++t) {
+            workers_.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    // Finishes every queued job, then stops the workers
+    ~VerificationService() { shutdown(); }
+
+    VerificationService(const VerificationService&) = delete;
+    VerificationService& operator=(const VerificationService&) = delete;
+
+    /**
+     * @brief Queues a job, waiting while the queue is full.
+     * After shutdown() the returned future holds false. Must not be called
+     * from a callback; use trySubmit() there.
+     */
+    std::future<bool> submit(MatrixPtr A, MatrixPtr B, MatrixPtr C, Callback onDone = nullptr) {
+        Job job{std::move(A), std::move(B), std::move(C), std::move(onDone), {}};
+        std::future<bool> result = job.promise.get_future();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            notFull_.wait(lock, [this] { return stopping_ || queue_.size() < capacity_; });
+            if (stopping_) {
+                lock.unlock();
+                finish(job, false);
+                return result;
+            }
+            queue_.push_back(std::move(job));
+        }
+        notEmpty_.notify_one();
+        return result;
+    }
+
+    /**
+     * @brief Queues a job only if there is room right now.
+     * @return false (and leaves result untouched) if the queue is full or stopped.
+     */
+    bool trySubmit(MatrixPtr A, MatrixPtr B, MatrixPtr C, std::future<bool>& result, Callback onDone = nullptr) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_ || queue_.size() >= capacity_) {
+                return false;
+            }
+            Job job{std::move(A), std::move(B), std::move(C), std::move(onDone), {}};
+            result = job.promise.get_future();
+            queue_.push_back(std::move(job));
+        }
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    // Number of jobs waiting for a worker
+    std::size_t pending() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.size();
+    }
+
+    // Stops accepting jobs, runs the queued ones and joins the workers
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        notEmpty_.notify_all();
+        notFull_.notify_all();
+        for (auto& worker : workers_) {
+            if (worker.joinable()) worker.join();
+        }
+    }
+
+private:
+    struct Job {
+        MatrixPtr A, B, C;
+        Callback onDone;
+        std::promise<bool> promise;
+
+        std::size_t entries() const {
+            return A->rows() * A->cols() + B->rows() * B->cols() + C->rows() * C->cols();
+        }
+    };
+
+    // The callback runs first, so a ready future means it has returned
+    static void finish(Job& job, bool verified) {
+        if (job.onDone) job.onDone(verified);
+        job.promise.set_value(verified);
+    }
+
+    /**
+     * @brief Computes M_k * x_k for every job k, where M_k is the job's
+     * operand selected by `operand`. Jobs with the same operand are
+     * multiplied as one m x g panel, a single pass over the shared matrix.
+     */
+    static std::vector<Vector> sharedProducts(const std::vector<Job*>& jobs, MatrixPtr Job::*operand,
+                                              const std::vector<Vector>& x) {
+        std::vector<Vector> y(jobs.size());
+        std::vector<bool> done(jobs.size(), false);
+        std::vector<std::size_t> group;
+        for (std::size_t k = 0; k < jobs.size(); ++k) {
+            if (done[k]) continue;
+            const Matrix& M = *(jobs[k]->*operand);
+            group.clear();
+            for (std::size_t l = k; l < jobs.size(); ++l) {
+                if ((jobs[l]->*operand).get() == &M) {
+                    group.push_back(l);
+                    done[l] = true;
+                }
+            }
+
+            // Gather the group's vectors as the columns of a panel
+            Matrix X(M.cols(), group.size());
+            for (std::size_t g = 0; g < group.size(); ++g) {
+                for (std::size_t i = 0; i < M.cols(); ++i) X(i, g) = x[group[g]][i];
+            }
+            Matrix MX = matrixPanelMultiply(M, X);
+            for (std::size_t g = 0; g < group.size(); ++g) {
+                Vector& column = y[group[g]];
+                column.resize(M.rows());
+                for (std::size_t i = 0; i < M.rows(); ++i) column[i] = MX(i, g);
+            }
+        }
+        return y;
+    }
+
+    // Verifies jobs that share operands: one round of A(Br) == Cr per job
+    static void runShared(std::vector<Job*>& jobs) {
+        std::vector<bool> verified(jobs.size());
+        try {
+            // 1. An independent random {0, 1} vector per job
+            std::mt19937_64 generator = seededGenerator();
+            std::vector<Vector> r(jobs.size());
+            for (std::size_t k = 0; k < jobs.size(); ++k) {
+                BitVector bits = randomBitVector(jobs[k]->B->cols(), generator);
+                r[k] = expandBits<int>(bits);
+            }
+
+            // 2. B r, A (B r) and C r, one pass over each distinct matrix
+            std::vector<Vector> Br = sharedProducts(jobs, &Job::B, r);
+            std::vector<Vector> A_Br = sharedProducts(jobs, &Job::A, Br);
+            std::vector<Vector> Cr = sharedProducts(jobs, &Job::C, r);
+            for (std::size_t k = 0; k < jobs.size(); ++k) verified[k] = A_Br[k] == Cr[k];
+        } catch (...) {
+            for (Job* job : jobs) {
+                if (job->onDone) job->onDone(false);
+                job->promise.set_exception(std::current_exception()); // e.g. std::bad_alloc
+            }
+            return;
+        }
+        for (std::size_t k = 0; k < jobs.size(); ++k) finish(*jobs[k], verified[k]);
+    }
+
+    // Runs the batch, grouping the well-formed jobs that share an operand
+    static void runBatch(std::vector<Job>& batch) {
+        auto sharesOperand = [&batch](const Job& job) {
+            for (const Job& other : batch) {
+                if (&other != &job && (other.A == job.A || other.B == job.B || other.C == job.C)) return true;
+            }
+            return false;
+        };
+        std::vector<Job*> shared;
+        for (Job& job : batch) {
+            if (batch.size() > 1 && productShapesMatch(*job.A, *job.B, *job.C) && sharesOperand(job)) {
+                shared.push_back(&job);
+            } else {
+                run(job); // Keeps the early exit and the left form
+            }
+        }
+        if (!shared.empty()) runShared(shared);
+    }
+
+    static void run(Job& job) {
+        bool verified = false;
+        try {
+            verified = freivaldsVerify(*job.A, *job.B, *job.C);
+        } catch (...) {
+            if (job.onDone) job.onDone(false);
+            job.promise.set_exception(std::current_exception()); // e.g. std::bad_alloc
+            return;
+        }
+        finish(job, verified);
+    }
+
+    void workerLoop() {
+        std::vector<Job> batch;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                notEmpty_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) return; // Stopping and drained
+
+                // Take one job, plus the small jobs right behind a small one
+                batch.push_back(std::move(queue_.front()));
+                queue_.pop_front();
+                if (batch.front().entries() <= kSmallJobEntries) {
+                    while (batch.size() < kMaxBatch && !queue_.empty() &&
+                           queue_.front().entries() <= kSmallJobEntries) {
+                        batch.push_back(std::move(queue_.front()));
+                        queue_.pop_front();
+                    }
+                }
+            }
+            notFull_.notify_all();
+
+            runBatch(batch);
+            batch.clear();
+        }
+    }
+
+    std::size_t capacity_;
+    std::deque<Job> queue_;
+    bool stopping_ = false;
+    mutable std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::vector<std::thread> workers_;
+};
+
+// --- Non-owning strided views ---
+
+enum class Layout { RowMajor, ColMajor };
+
+/**
+ * @brief A read-only view of a matrix in someone else's buffer.
+ *
+ * Entry (i, j) is data[i * ld + j] in RowMajor layout and data[j * ld + i]
+ * in ColMajor layout, where the leading dimension ld >= cols (resp. rows)
+ * lets the view describe a submatrix of a larger array, as in BLAS.
+ * Nothing is copied; the buffer must outlive the view.
+ */
+template <typename T>
+class MatrixView {
+public:
+    using value_type = T;
+
+    MatrixView() = default;
+
+    MatrixView(const T* data, std::size_t rows, std::size_t cols, Layout layout, std::size_t ld = 0)
+        : data_(data), rows_(rows), cols_(cols), layout_(layout),
+          ld_(ld != 0 ? ld : layout == Layout::RowMajor ? cols : rows) {}
+
+    // Views a BasicMatrix in place (row-major, with its padded stride)
+    MatrixView(const BasicMatrix<T>& M) : MatrixView(M.row(0), M.rows(), M.cols(), Layout::RowMajor, M.stride()) {}
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+    Layout layout() const { return layout_; }
+    std::size_t leadingDimension() const { return ld_; }
+
+    // The contiguous run of ld elements: a row (RowMajor) or a column (ColMajor)
+    const T* line(std::size_t k) const { return data_ + k * ld_; }
+
+    T operator()(std::size_t i, std::size_t j) const {
+        return layout_ == Layout::RowMajor ? data_[i * ld_ + j] : data_[j * ld_ + i];
+    }
+
+    // The transpose is the same buffer read in the other layout
+    MatrixView transposed() const {
+        return MatrixView(data_, cols_, rows_, layout_ == Layout::RowMajor ? Layout::ColMajor : Layout::RowMajor, ld_);
+    }
+
+    // The rows x cols block whose top-left corner is (row, col)
+    MatrixView block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const {
+        const T* corner = layout_ == Layout::RowMajor ? data_ + row * ld_ + col : data_ + col * ld_ + row;
+        return MatrixView(corner, rows, cols, layout_, ld_);
+    }
+
+private:
+    const T* data_ = nullptr;
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    Layout layout_ = Layout::RowMajor;
+    std::size_t ld_ = 0;
+};
+
+// A view is already a pointer to the buffer, so chain factors copy it
+template <typename T>
+struct ChainFactor<MatrixView<T>> {
+    MatrixView<T> matrix;
+    bool transposed = false;
+
+    std::size_t rows() const { return transposed ? matrix.cols() : matrix.rows(); }
+    std::size_t cols() const { return transposed ? matrix.rows() : matrix.cols(); }
+};
+
+template <typename T>
+ChainFactor<MatrixView<T>> asFactor(MatrixView<T> view) { return {view, false}; }
+
+template <typename T>
+ChainFactor<MatrixView<T>> asTransposedFactor(MatrixView<T> view) { return {view, true}; }
+
+/**
+ * @brief Multiplies a strided view by a vector, streaming whichever way
+ * the view is contiguous: one dot product per row for RowMajor, one axpy
+ * per column for ColMajor (skipping columns whose x entry is zero). Both
+ * use the SIMD kernels and neither copies the matrix.
+ */
+template <typename T, typename Acc>
+std::vector<Acc> matrixVectorMultiply(const MatrixView<T>& M, const std::vector<Acc>& x) {
+    std::vector<Acc> result(M.rows(), 0);
+    if (M.layout() == Layout::RowMajor) {
+        for (std::size_t i = 0; i < M.rows(); ++i) {
+            result[i] = dotProduct(M.line(i), x.data(), M.cols());
+        }
+    } else {
+        for (std::size_t j = 0; j < M.cols(); ++j) {
+            if (x[j] != 0) axpy(x[j], M.line(j), result.data(), M.rows());
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Multiplies the transpose of a strided view by a vector; the
+ * transpose is a view too, so this is free of copies as well.
+ */
+template <typename T, typename Acc>
+std::vector<Acc> transposeVectorMultiply(const MatrixView<T>& M, const std::vector<Acc>& x) {
+    return matrixVectorMultiply(M.transposed(), x);
+}
+
+/**
+ * @brief Computes (M x, |M| xAbs) for a strided view in one pass, where
+ * xAbs >= 0 bounds |x| entrywise; the floating-point counterpart of
+ * matrixVectorMultiply, feeding the tolerant comparison. Columns are not
+ * skipped on zero entries of x, so a NaN anywhere in M shows up.
+ */
+template <typename T, typename Acc>
+std::pair<std::vector<Acc>, std::vector<Acc>> matrixVectorMultiplyWithMagnitude(const MatrixView<T>& M,
+                                                                                const std::vector<Acc>& x,
+                                                                                const std::vector<Acc>& xAbs) {
+    std::vector<Acc> result(M.rows(), 0), magnitude(M.rows(), 0);
+    if (M.layout() == Layout::RowMajor) {
+        for (std::size_t i = 0; i < M.rows(); ++i) {
+            std::tie(result[i], magnitude[i]) = dotProductWithMagnitude(M.line(i), x.data(), xAbs.data(), M.cols());
+        }
+    } else {
+        for (std::size_t j = 0; j < M.cols(); ++j) {
+            const T* column = M.line(j);
+            for (std::size_t i = 0; i < M.rows(); ++i) {
+                Acc a = static_cast<Acc>(column[i]);
+                result[i] += a * x[j];
+                magnitude[i] += std::abs(a) * xAbs[j];
+            }
+        }
+    }
+    return {result, magnitude};
+}
+
+/**
+ * @brief Freivalds' technique for strided views (single iteration).
+ *
+ * Typed like the BasicMatrix version: A and B share element type T, C may
+ * be wider, and both sides are evaluated in Acc. Integer views are
+ * compared exactly; floating-point views (the usual BLAS case) accept a
+ * row within the same forward error bound as freivaldsVerify on
+ * BasicMatrix operands.
+ * @return true if A(Br) and Cr agree, false otherwise.
+ */
+template <typename T, typename TC, typename Acc = typename FreivaldsTraits<T>::Accumulator>
+bool freivaldsVerify(const MatrixView<T>& A, const MatrixView<T>& B, const MatrixView<TC>& C) {
+    if (!productShapesMatch(A, B, C)) {
+        return false; // Invalid dimensions
+    }
+    std::size_t m = B.rows();
+    std::size_t p = B.cols();
+
+    // 1. Generate random p x 1 vector r with {0, 1} entries in Acc
+    std::mt19937_64 generator = seededGenerator();
+    std::vector<Acc> r = expandBits<Acc>(randomBitVector(p, generator));
+
+    if constexpr (std::is_floating_point_v<Acc>) {
+        // 2. Compute A * (B * r) and C * r with their magnitudes  (O(nm + mp + np))
+        auto [Br, BrAbs] = matrixVectorMultiplyWithMagnitude(B, r, r);
+        auto [A_Br, A_BrAbs] = matrixVectorMultiplyWithMagnitude(A, Br, BrAbs);
+        auto [Cr, CrAbs] = matrixVectorMultiplyWithMagnitude(C, r, r);
+
+        // 3. Compare row by row against the forward error bound
+        double gamma = dotProductErrorBound<T>(m + 1) + dotProductErrorBound<Acc>(m + p);
+        return compareProjections(A_Br, A_BrAbs, Cr, CrAbs, gamma).passed;
+    } else {
+        // 2. Compute A * (B * r) and C * r, then compare exactly
+        return matrixVectorMultiply(A, matrixVectorMultiply(B, r)) == matrixVectorMultiply(C, r);
+    }
+}
+
+/**
+ * @brief Verifies a chain of strided views, A1 * A2 * ... * Ak = C
+ * (single iteration), typed like freivaldsVerify on views.
+ *
+ * Floating-point chains carry |A1| ... |Ak| r along with the product and
+ * accept within the forward error bound of forming the chain in T (the
+ * inner dimensions add up) plus that of the check in Acc.
+ * @return true if A1(A2(...(Ak r))) and Cr agree, false otherwise.
+ */
+template <typename T, typename TC, typename Acc = typename FreivaldsTraits<T>::Accumulator>
+bool freivaldsVerifyChain(const std::vector<ChainFactor<MatrixView<T>>>& factors, const MatrixView<TC>& C) {
+    if (!chainShapesMatch(factors, C)) {
+        return false; // Invalid dimensions
+    }
+
+    // 1. Generate random p x 1 vector r with {0, 1} entries in Acc
+    std::mt19937_64 generator = seededGenerator();
+    std::vector<Acc> r = expandBits<Acc>(randomBitVector(C.cols(), generator));
+
+    // 2. Push r through the chain from right to left; a transposed factor is
+    //    the transposed view of the same buffer
+    auto factorView = [](const ChainFactor<MatrixView<T>>& factor) {
+        return factor.transposed ? factor.matrix.transposed() : factor.matrix;
+    };
+    if constexpr (std::is_floating_point_v<Acc>) {
+        std::vector<Acc> x = r, xAbs = r;
+        std::size_t innerDims = 0;
+        std::size_t checkDims = C.cols();
+        for (std::size_t i = factors.size(); i-- > 0;) {
+            std::tie(x, xAbs) = matrixVectorMultiplyWithMagnitude(factorView(factors[i]), x, xAbs);
+            if (i > 0) innerDims += factors[i].rows();
+            checkDims += factors[i].cols();
+        }
+
+        // 3. Compare with C * r against the forward error bound
+        auto [Cr, CrAbs] = matrixVectorMultiplyWithMagnitude(C, r, r);
+        double gamma = dotProductErrorBound<T>(innerDims + 1) + dotProductErrorBound<Acc>(checkDims);
+        return compareProjections(x, xAbs, Cr, CrAbs, gamma).passed;
+    } else {
+        std::vector<Acc> x = r;
+        for (std::size_t i = factors.size(); i-- > 0;) {
+            x = matrixVectorMultiply(factorView(factors[i]), x);
+        }
+
+        // 3. Compare with C * r  (O(np))
+        return x == matrixVectorMultiply(C, r);
+    }
 }
 
 // Helper function to print a matrix
 void printMatrix(const Matrix& M) {
-    for (const auto& row : M) {
-        for (int val : row) {
-            std::cout << val << "\t";
+    for (std::size_t i = 0; i < M.rows(); ++i) {
+        for (std::size_t j = 0; j < M.cols(); ++j) {
+            std::cout << M(i, j) << "\t";
         }
         std::cout << std::endl;
     }
@@ -79,7 +2379,7 @@ void printMatrix(const Matrix& M) {
 // Main function to demonstrate the algorithm
 int main() {
     int n = 3;
-    
+
     // Case 1: A * B = C (Correct)
     Matrix A = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
     Matrix B = {{9, 8, 7}, {6, 5, 4}, {3, 2, 1}};
@@ -88,7 +2388,7 @@ int main() {
 
     // Case 2: A * B != C (Incorrect)
     Matrix C_incorrect = {{30, 24, 18}, {84, 69, 54}, {138, 114, 91}}; // One entry is wrong
-    
+
     std::cout << "Verifying A * B = C_correct (should be true):" << std::endl;
     bool result1 = freivaldsVerify(A, B, C_correct);
     std::cout << "Result: " << (result1 ? "Verified" : "Failed") << std::endl;
@@ -96,20 +2396,143 @@ int main() {
     std::cout << "\nVerifying A * B = C_incorrect (should be false):" << std::endl;
     bool result2 = freivaldsVerify(A, B, C_incorrect);
     std::cout << "Result: " << (result2 ? "Verified" : "Failed") << std::endl;
-    
+
     // Note: result2 has a < 50% chance of being "Verified" (false positive).
-    // To be sure, we run it k times.
+    // To be sure, we run k rounds, batched into one pass over the matrices.
     int k = 10;
-    bool overallResult = true;
-    for(int i = 0; i < k; ++i) {
-        if (!freivaldsVerify(A, B, C_incorrect)) {
-            overallResult = false;
-            break; // Found a discrepancy, definitely not equal
-        }
-    }
+    bool overallResult = freivaldsVerifyBatch(A, B, C_incorrect, k);
     std::cout << "After " << k << " iterations, verification of incorrect C: ";
     std::cout << (overallResult ? "Verified (False Positive)" : "Failed (Correctly Identified)") << std::endl;
 
+    // Over Z_p a single round already has error probability <= 1/p.
+    std::cout << "\nVerifying over Z_p, p = 2^61 - 1 (single round):" << std::endl;
+    std::cout << "C_correct:   " << (freivaldsVerifyModP(A, B, C_correct) ? "Verified" : "Failed") << std::endl;
+    std::cout << "C_incorrect: " << (freivaldsVerifyModP(A, B, C_incorrect) ? "Verified" : "Failed") << std::endl;
+
+    // After a failure, find out which entries of C are wrong.
+    FreivaldsFaults faults = freivaldsLocalizeErrors(A, B, C_incorrect);
+    std::cout << "Wrong entries of C_incorrect:";
+    for (const auto& entry : faults.entries) {
+        std::cout << " (" << entry.first << ", " << entry.second << ")";
+    }
+    std::cout << std::endl;
+
+    std::cout << "\nVerifying with rows split across threads:" << std::endl;
+    std::cout << "C_correct:   " << (freivaldsVerifyParallel(A, B, C_correct) ? "Verified" : "Failed") << std::endl;
+
+    // Stream C_incorrect in as 1 x 3 and 2 x 3 tiles, bottom tile first.
+    std::cout << "\nStreaming tiles of C_incorrect (one band per row):" << std::endl;
+    TileStreamVerifier stream(A, B, 1, [](std::size_t band, bool passed) {
+        std::cout << "Band " << band << ": " << (passed ? "Verified" : "Failed") << std::endl;
+    });
+    Matrix bottom = {{138, 114, 91}};
+    Matrix top = {{30, 24, 18}, {84, 69, 54}};
+    stream.addTile(2, 0, bottom);
+    stream.addTile(0, 0, top);
+
+    // Round-trip the matrices through files and verify them out of core.
+    std::string dir = std::filesystem::temp_directory_path().string();
+    std::string pathA = dir + "/freivalds_A.bin";
+    std::string pathB = dir + "/freivalds_B.bin";
+    std::string pathC = dir + "/freivalds_C.bin";
+    if (writeMatrixFile(pathA, A) && writeMatrixFile(pathB, B) && writeMatrixFile(pathC, C_correct)) {
+        std::cout << "\nVerifying memory-mapped files:" << std::endl;
+        std::cout << "C_correct:   " << (freivaldsVerifyFiles(pathA, pathB, pathC) ? "Verified" : "Failed") << std::endl;
+    }
+    std::remove(pathA.c_str());
+    std::remove(pathB.c_str());
+    std::remove(pathC.c_str());
+
+    // Sparse and dense operands can be mixed freely.
+    std::cout << "\nVerifying CSR(A) * CSC(B) = C:" << std::endl;
+    CsrMatrix sparseA = CsrMatrix::fromDense(A);
+    CscMatrix sparseB = CscMatrix::fromDense(B);
+    std::cout << "C_correct:   " << (freivaldsVerify(sparseA, sparseB, C_correct) ? "Verified" : "Failed") << std::endl;
+
+    // Rectangular shapes: a tall-skinny (4 x 2) * (2 x 3) product.
+    Matrix tallA = {{1, 2}, {3, 4}, {5, 6}, {7, 8}};
+    Matrix wideB = {{1, 0, 2}, {0, 1, 3}};
+    Matrix tallC = {{1, 2, 8}, {3, 4, 18}, {5, 6, 28}, {7, 8, 38}};
+    std::cout << "\nVerifying a (4 x 2) * (2 x 3) product:" << std::endl;
+    std::cout << "Result: " << (freivaldsVerify(tallA, wideB, tallC) ? "Verified" : "Failed") << std::endl;
+
+    // Other element types: int8 inputs with an int32 result, and fp32.
+    BasicMatrix<std::int8_t> qA = {{1, -2}, {3, 4}};
+    BasicMatrix<std::int8_t> qB = {{5, 6}, {-7, 8}};
+    BasicMatrix<std::int32_t> qC = {{19, -10}, {-13, 50}};
+    std::cout << "\nVerifying an int8 product with int32 result:" << std::endl;
+    std::cout << "Result: " << (freivaldsVerify(qA, qB, qC) ? "Verified" : "Failed") << std::endl;
+
+    BasicMatrix<float> fA = {{0.1f, 0.2f}, {0.3f, 0.4f}};
+    BasicMatrix<float> fB = {{1.5f, -2.0f}, {0.25f, 3.0f}};
+    BasicMatrix<float> fC(2, 2);
+    for (std::size_t i = 0; i < 2; ++i) {
+        for (std::size_t j = 0; j < 2; ++j) {
+            fC(i, j) = fA(i, 0) * fB(0, j) + fA(i, 1) * fB(1, j); // Rounded in fp32
+        }
+    }
+    std::cout << "Verifying an fp32 product (within rounding error):" << std::endl;
+    std::cout << "Result: " << (freivaldsVerify(fA, fB, fC) ? "Verified" : "Failed") << std::endl;
+
+    // GF(2): the all-ones 2 x 2 matrix squares to zero, since 1 + 1 = 0
+    BitMatrix gA = BitMatrix::fromDense({{1, 1}, {1, 1}});
+    BitMatrix gC(2, 2);
+    std::cout << "\nVerifying a GF(2) product (bit-packed, 64 rounds):" << std::endl;
+    std::cout << "Result: " << (freivaldsVerifyGF2Batch(gA, gA, gC) ? "Verified" : "Failed") << std::endl;
+
+    // Chain: A * A^T * A with A = [[1, 2], [3, 4]] (A A^T = [[5, 11], [11, 25]])
+    Matrix chainA = {{1, 2}, {3, 4}};
+    Matrix chainC = {{38, 54}, {86, 122}};
+    std::vector<ChainFactor<Matrix>> chain = {asFactor(chainA), asTransposedFactor(chainA), asFactor(chainA)};
+    std::cout << "\nVerifying the chain A * A^T * A = C:" << std::endl;
+    std::cout << "Result: " << (freivaldsVerifyChain(chain, chainC) ? "Verified" : "Failed") << std::endl;
+
+    // Views: B as a column-major buffer (as BLAS would hand it over), no copies
+    const int bColumnMajor[] = {9, 6, 3, 8, 5, 2, 7, 4, 1};
+    MatrixView<int> viewB(bColumnMajor, 3, 3, Layout::ColMajor);
+    std::cout << "\nVerifying A * B = C with B as a column-major view:" << std::endl;
+    bool viewVerified = freivaldsVerify(MatrixView<int>(A), viewB, MatrixView<int>(C_correct));
+    std::cout << "Result: " << (viewVerified ? "Verified" : "Failed") << std::endl;
+
+    // The same with fp32 data, as BLAS usually hands it over
+    const float fbColumnMajor[] = {1.5f, 0.25f, -2.0f, 3.0f};
+    MatrixView<float> fViewB(fbColumnMajor, 2, 2, Layout::ColMajor);
+    BasicMatrix<float> fZero(2, 2);
+    int zeroRejected = 0;
+    for (int k = 0; k < 20; ++k) {
+        zeroRejected += !freivaldsVerify(MatrixView<float>(fA), fViewB, MatrixView<float>(fZero));
+    }
+    bool fViewVerified = freivaldsVerify(MatrixView<float>(fA), fViewB, MatrixView<float>(fC));
+    std::cout << "Verifying an fp32 product with B as a column-major view:" << std::endl;
+    std::cout << "Result: " << (fViewVerified ? "Verified" : "Failed") << " (an all-zero C is rejected in " << zeroRejected << " of 20 rounds)" << std::endl;
+
+    // LU with pivoting of A = [[1, 2], [4, 3]]: P swaps the rows, L U = [[4, 3], [1, 2]]
+    BasicMatrix<double> luA = {{1, 2}, {4, 3}};
+    BasicMatrix<double> luL = {{1, 0}, {0.25, 1}};
+    BasicMatrix<double> luU = {{4, 3}, {0, 1.25}};
+    CertificateResult lu = certifyLU(luL, luU, {1, 0}, luA);
+    std::cout << "\nCertifying L U = P A:" << std::endl;
+    std::cout << "Result: " << (lu.passed ? "Verified" : "Failed") << " (relative residual " << lu.relativeResidual
+              << ")" << std::endl;
+
+    // Asynchronous service: jobs share their matrices with the workers
+    {
+        VerificationService service(2);
+        auto sA = std::make_shared<const Matrix>(A);
+        auto sB = std::make_shared<const Matrix>(B);
+        std::future<bool> good = service.submit(sA, sB, std::make_shared<const Matrix>(C_correct));
+        auto sC = std::make_shared<const Matrix>(C_incorrect);
+        std::vector<std::future<bool>> rounds;
+        for (int k = 0; k < 10; ++k) {
+            rounds.push_back(service.submit(sA, sB, sC)); // Independent single rounds
+        }
+        int rejected = 0;
+        for (auto& round : rounds) rejected += !round.get();
+        std::cout << "\nVerifying through the asynchronous service:" << std::endl;
+        std::cout << "C_correct:   " << (good.get() ? "Verified" : "Failed") << std::endl;
+        std::cout << "C_incorrect: rejected by " << rejected << " of 10 jobs" << std::endl;
+    }
+
 
     return 0;
 }
\ No newline at end of file
@@ -8,62 +8,116 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cmath>
+#include <cstdint>
+#include <map>
+#include <algorithm>
+#include <cstring>      // For std::memcmp / std::memmove
+#include <functional>
+#include <thread>
+#include <istream>
+#include <sstream>      // For the streaming demo
+#include <random>       // For std::random_device, std::mt19937_64
+#include <chrono>       // For timing the parallel demo
+#include <fstream>
+#include <filesystem>   // For the demo's temporary file
 
-// We use long long to avoid overflow during intermediate calculations
-using ll = long long;
+// POSIX memory mapping for the file search
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-// d: size of the alphabet (e.g., 256 for ASCII)
-const int d = 256;
-// p: A large prime number for the modulo operation
-const ll p = 1000000007;
+// p: the Mersenne prime 2^61 - 1. Reduction modulo p needs only shifts and
+// adds, and two different m-byte strings get the same hash with probability
+// at most (m - 1) / p over the random base (below 2^-50 for m < 2048).
+const std::uint64_t p = (1ULL << 61) - 1;
 
 /**
- * @brief Helper function to compute (base^exp) % mod efficiently.
+ * @brief Computes (a * b) % p for a, b < 2^62 with one 128-bit multiply,
+ * folding the high bits down using 2^61 = 1 (mod p).
  */
-ll power(ll base, ll exp) {
-    ll res = 1;
-    base %= p;
+inline std::uint64_t mulMod(std::uint64_t a, std::uint64_t b) {
+    unsigned __int128 x = static_cast<unsigned __int128>(a) * b;
+    std::uint64_t t = static_cast<std::uint64_t>(x & p) + static_cast<std::uint64_t>(x >> 61);
+    t = (t & p) + (t >> 61);
+    return t >= p ? t - p : t;
+}
+
+/**
+ * @brief Computes (hash * base + c) % p: appends byte c to a hash.
+ * hash may be anything below 2p.
+ */
+inline std::uint64_t appendByte(std::uint64_t hash, std::uint64_t base, unsigned char c) {
+    std::uint64_t x = mulMod(hash, base) + c;
+    return x >= p ? x - p : x;
+}
+
+/**
+ * @brief Helper function to compute (base^exp) % p efficiently.
+ */
+std::uint64_t power(std::uint64_t base, std::uint64_t exp) {
+    std::uint64_t res = 1;
     while (exp > 0) {
-        if (exp % 2 == 1) res = (res * base) % p;
-        base = (base * base) % p;
+        if (exp % 2 == 1) res = mulMod(res, base);
+        base = mulMod(base, base);
         exp /= 2;
     }
     return res;
 }
 
+/**
+ * @brief Draws the hash base uniformly from [256, p). A fresh base for each
+ * search is what makes the collision bound hold for every input, so the
+ * generator gets 128 bits from std::random_device: a clock seed would allow
+ * only 2^32 bases and repeat the base for searches started together.
+ */
+std::uint64_t randomBase() {
+    std::random_device device;
+    std::seed_seq seeds{device(), device(), device(), device()};
+    std::mt19937_64 generator(seeds);
+    std::uniform_int_distribution<std::uint64_t> distribution(256, p - 1);
+    return distribution(generator);
+}
+
 /**
  * @brief Finds guaranteed occurrences of a pattern in a text using Karp-Rabin.
- * @param text The text string to search in.
+ * @param text The text to search in: n bytes, e.g. a memory-mapped file.
+ * @param n The length of the text; offsets are 64-bit, so n may exceed 2 GB.
  * @param pattern The pattern string to search for.
  * @return A vector of 0-based indices where the pattern starts in the text.
  */
-std::vector<int> karpRabinLasVegas(const std::string& text, const std::string& pattern) {
-    std::vector<int> matches;
-    int n = text.length();
-    int m = pattern.length();
+std::vector<std::uint64_t> karpRabinLasVegas(const char* text, std::size_t n, const std::string& pattern) {
+    std::vector<std::uint64_t> matches;
+    std::size_t m = pattern.length();
     
     if (m == 0 || m > n) return matches;
 
-    ll patternHash = 0;
-    ll textHash = 0;
-    ll h = power(d, m - 1); // h = d^(m-1) % p
+    std::uint64_t base = randomBase();
+    std::uint64_t h = power(base, m - 1); // h = base^(m-1) % p
+
+    // outgoing[c] = c * h % p: what a leading byte c contributes to the window
+    std::uint64_t outgoing[256];
+    for (int c = 0; c < 256; ++c) outgoing[c] = mulMod(c, h);
 
     // Calculate the hash value of the pattern and the first window of the text
-    for (int i = 0; i < m; ++i) {
-        patternHash = (d * patternHash + pattern[i]) % p;
-        textHash = (d * textHash + text[i]) % p;
+    std::uint64_t patternHash = 0;
+    std::uint64_t textHash = 0;
+    for (std::size_t i = 0; i < m; ++i) {
+        patternHash = appendByte(patternHash, base, pattern[i]);
+        textHash = appendByte(textHash, base, text[i]);
     }
 
     // Slide the pattern over the text one by one
-    for (int j = 0; j <= n - m; ++j) {
+    for (std::size_t j = 0; j <= n - m; ++j) {
         
         // Check if the hash values match
         if (patternHash == textHash) {
             // Las Vegas: Hashes match, now verify deterministically
             bool match = true;
-            for (int i = 0; i < m; ++i) {
+            for (std::size_t i = 0; i < m; ++i) {
                 if (text[j + i] != pattern[i]) {
                     match = false;
                     break;
@@ -76,14 +130,699 @@ std::vector<int> karpRabinLasVegas(const std::string& text, const std::string& p
 
         // Calculate the hash value for the next window
         if (j < n - m) {
-            ll term1 = (textHash - (ll)text[j] * h) % p;
-            ll term2 = (d * (term1 + p)) % p; // Add p to handle potential negative
-            textHash = (term2 + text[j + m]) % p;
+            // Remove leading byte, add trailing byte: (textHash - text[j] * h) * base + text[j + m]
+            textHash = appendByte(textHash + p - outgoing[static_cast<unsigned char>(text[j])], base, text[j + m]);
+        }
+    }
+    return matches;
+}
+
+/**
+ * @brief Finds guaranteed occurrences of a pattern in a string.
+ */
+std::vector<std::uint64_t> karpRabinLasVegas(const std::string& text, const std::string& pattern) {
+    return karpRabinLasVegas(text.data(), text.size(), pattern);
+}
+
+// --- Parallel search ---
+
+// Threads are only worth starting for at least this many windows each
+constexpr std::size_t kMinWindowsPerThread = 1 << 20;
+
+/**
+ * @brief Finds guaranteed occurrences of a pattern using several threads.
+ *
+ * The n - m + 1 window start positions are split into one contiguous range
+ * per thread. Each thread reads its range plus the m - 1 bytes after it,
+ * computes the hash of its own first window directly, and then rolls and
+ * verifies like karpRabinLasVegas. All threads share one random base, so
+ * the pattern is hashed once. Because the ranges partition the start
+ * positions, concatenating the per-thread results in range order already
+ * gives the sorted global list, with no duplicates to remove.
+ * @param numThreads Threads to use; 0 means one per hardware thread.
+ */
+std::vector<std::uint64_t> karpRabinLasVegasParallel(const char* text, std::size_t n, const std::string& pattern,
+                                                     unsigned numThreads = 0) {
+    std::size_t m = pattern.length();
+    if (m == 0 || m > n) return {};
+    std::size_t windows = n - m + 1;
+    if (numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+    numThreads = static_cast<unsigned>(std::min<std::size_t>(numThreads, windows / kMinWindowsPerThread + 1));
+
+    std::uint64_t base = randomBase();
+    std::uint64_t h = power(base, m - 1); // h = base^(m-1) % p
+    std::uint64_t outgoing[256];
+    for (int c = 0; c < 256; ++c) outgoing[c] = mulMod(c, h);
+    std::uint64_t patternHash = 0;
+    for (char c : pattern) patternHash = appendByte(patternHash, base, c);
+
+    // Each thread scans window starts [begin, end) into its own result list
+    std::vector<std::vector<std::uint64_t>> found(numThreads);
+    auto scan = [&](std::size_t begin, std::size_t end, std::vector<std::uint64_t>& matches) {
+        std::uint64_t textHash = 0;
+        for (std::size_t i = 0; i < m; ++i) textHash = appendByte(textHash, base, text[begin + i]);
+        for (std::size_t j = begin; j < end; ++j) {
+            if (textHash == patternHash && std::memcmp(text + j, pattern.data(), m) == 0) {
+                matches.push_back(j);
+            }
+            if (j + 1 < end) {
+                textHash = appendByte(textHash + p - outgoing[static_cast<unsigned char>(text[j])], base, text[j + m]);
+            }
         }
+    };
+
+    std::vector<std::thread> threads;
+    std::size_t chunk = (windows + numThreads - 1) / numThreads;
+    for (unsigned t = 0; t < numThreads; ++t) {
+        std::size_t begin = std::min(windows, t * chunk);
+        std::size_t end = std::min(windows, begin + chunk);
+        threads.emplace_back(scan, begin, end, std::ref(found[t]));
     }
+    for (auto& thread : threads) thread.join();
+
+    // Stitch the ranges together in order
+    std::vector<std::uint64_t> matches;
+    for (const auto& part : found) matches.insert(matches.end(), part.begin(), part.end());
     return matches;
 }
 
+// --- Searching memory-mapped files (POSIX) ---
+
+/**
+ * @brief A read-only mapping of a whole file. The search runs directly over
+ * the mapped pages, so the file is never copied into a std::string.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    // Maps the file at path; returns false if it cannot be opened or mapped
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ > 0) {
+            void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                size_ = 0;
+                return false;
+            }
+            madvise(addr, size_, MADV_SEQUENTIAL); // One front-to-back pass: read ahead aggressively
+            data_ = static_cast<const char*>(addr);
+        }
+        ::close(fd); // The mapping stays valid after the descriptor is closed
+        return true;
+    }
+
+    void close() {
+        if (data_ != nullptr) munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/**
+ * @brief Finds guaranteed occurrences of a pattern in a file of any size by
+ * running the search over a read-only mapping of it.
+ * @param matches Receives the 64-bit offsets of the matches.
+ * @param numThreads 1 for a serial scan, otherwise as for karpRabinLasVegasParallel.
+ * @return false if the file cannot be opened or mapped.
+ */
+bool karpRabinLasVegasFile(const std::string& path, const std::string& pattern, std::vector<std::uint64_t>& matches,
+                           unsigned numThreads = 1) {
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    matches = numThreads == 1 ? karpRabinLasVegas(file.data(), file.size(), pattern)
+                              : karpRabinLasVegasParallel(file.data(), file.size(), pattern, numThreads);
+    return true;
+}
+
+// --- Multi-pattern search ---
+
+/**
+ * @brief One occurrence found by the multi-pattern search: patterns[pattern]
+ * starts at text[position].
+ */
+struct PatternMatch {
+    std::uint64_t position;
+    std::size_t pattern;
+
+    bool operator<(const PatternMatch& other) const {
+        return position != other.position ? position < other.position : pattern < other.pattern;
+    }
+};
+
+/**
+ * @brief Fingerprint of the m bytes at s under the given base.
+ */
+std::uint64_t windowHash(const char* s, std::size_t m, std::uint64_t base) {
+    std::uint64_t hash = 0;
+    for (std::size_t i = 0; i < m; ++i) {
+        hash = appendByte(hash, base, s[i]);
+    }
+    return hash;
+}
+
+/**
+ * @brief Open-addressing hash table from fingerprint to the patterns of
+ * one length that have it. Each slot holds a fingerprint and the first
+ * pattern with it; patterns sharing a fingerprint are chained through next.
+ * The table is at most half full, so a lookup costs one probe on average.
+ */
+class PatternTable {
+public:
+    static constexpr std::size_t kNone = ~std::size_t{0}; // End of a chain
+
+    PatternTable(const std::vector<std::uint64_t>& hashes, const std::vector<std::size_t>& members,
+                 std::size_t patternCount)
+        : next_(patternCount, kNone) {
+        std::size_t capacity = 2;
+        while (capacity < 2 * members.size()) capacity *= 2;
+        keys_.assign(capacity, kEmpty);
+        heads_.assign(capacity, kNone);
+        mask_ = capacity - 1;
+        for (std::size_t index : members) {
+            std::size_t slot = find(hashes[index]);
+            keys_[slot] = hashes[index];
+            next_[index] = heads_[slot];
+            heads_[slot] = index;
+        }
+    }
+
+    // First pattern with this fingerprint (follow next() for the rest), or kNone
+    std::size_t lookup(std::uint64_t hash) const { return heads_[find(hash)]; }
+
+    std::size_t next(std::size_t pattern) const { return next_[pattern]; }
+
+private:
+    static constexpr std::uint64_t kEmpty = ~0ULL; // Never a hash, which is below p
+
+    // Linear probing from a multiplicatively mixed start slot
+    std::size_t find(std::uint64_t hash) const {
+        std::size_t slot = (hash * 0x9E3779B97F4A7C15ULL >> 32) & mask_;
+        while (keys_[slot] != kEmpty && keys_[slot] != hash) {
+            slot = (slot + 1) & mask_;
+        }
+        return slot;
+    }
+
+    std::vector<std::uint64_t> keys_;
+    std::vector<std::size_t> heads_;
+    std::vector<std::size_t> next_;
+    std::size_t mask_ = 0;
+};
+
+/**
+ * @brief Finds guaranteed occurrences of many patterns in one text.
+ *
+ * Patterns are grouped by length. For each distinct length m, all the
+ * patterns of that length go into one PatternTable keyed by fingerprint,
+ * and a single rolling hash over the text probes the table once per
+ * window. Every fingerprint hit is verified byte by byte (Las Vegas), so
+ * the cost is O(n) per distinct length plus O(m) per verified candidate,
+ * instead of O(n) per pattern.
+ * @return All (position, pattern index) pairs, sorted by position.
+ */
+std::vector<PatternMatch> karpRabinLasVegasMulti(const std::string& text, const std::vector<std::string>& patterns) {
+    std::vector<PatternMatch> matches;
+    std::size_t n = text.length();
+    std::size_t count = patterns.size();
+
+    // Group pattern indices by length, skipping ones that cannot occur
+    std::uint64_t base = randomBase();
+    std::map<std::size_t, std::vector<std::size_t>> byLength;
+    std::vector<std::uint64_t> patternHashes(count);
+    for (std::size_t k = 0; k < count; ++k) {
+        std::size_t m = patterns[k].length();
+        if (m == 0 || m > n) continue;
+        byLength[m].push_back(k);
+        patternHashes[k] = windowHash(patterns[k].data(), m, base);
+    }
+
+    for (const auto& [m, members] : byLength) {
+        PatternTable table(patternHashes, members, count);
+        std::uint64_t h = power(base, m - 1); // h = base^(m-1) % p
+        std::uint64_t outgoing[256];
+        for (int c = 0; c < 256; ++c) outgoing[c] = mulMod(c, h);
+        std::uint64_t textHash = windowHash(text.data(), m, base);
+
+        // One rolling hash for every pattern of length m
+        for (std::size_t j = 0; j <= n - m; ++j) {
+            for (std::size_t k = table.lookup(textHash); k != PatternTable::kNone; k = table.next(k)) {
+                // Las Vegas: fingerprints match, now verify deterministically
+                if (text.compare(j, m, patterns[k]) == 0) {
+                    matches.push_back({j, k});
+                }
+            }
+
+            // Calculate the hash value for the next window
+            if (j < n - m) {
+                textHash = appendByte(textHash + p - outgoing[static_cast<unsigned char>(text[j])], base, text[j + m]);
+            }
+        }
+    }
+
+    std::sort(matches.begin(), matches.end());
+    return matches;
+}
+
+// --- Longest repeated / common substring ---
+
+/**
+ * @brief A longest repeated or common substring: length bytes starting at
+ * each of positions. Empty positions mean no nonempty substring qualifies.
+ */
+struct SubstringMatch {
+    std::uint64_t length = 0;
+    std::vector<std::uint64_t> positions;
+};
+
+// Default cap on the fingerprint table of the longest-substring searches
+constexpr std::size_t kMaxTableBytes = std::size_t(1) << 30;
+
+/**
+ * @brief Open-addressing set of window fingerprints, with an optional
+ * per-entry mark for intersecting three or more texts.
+ *
+ * A slot is just the 8-byte fingerprint (plus a 4-byte mark); positions
+ * are not stored, since only the final answer needs one and a rescan finds
+ * it. The table is kept at most half full, so it takes 16 bytes per window
+ * (24 with marks), and it is allocated once within a byte budget. When a
+ * probe has more windows than fit, the fingerprints are split into passes
+ * by value: each pass rescans the text but only keeps the fingerprints it
+ * owns, so equal windows always meet in the same pass.
+ */
+class FingerprintMap {
+public:
+    FingerprintMap(std::size_t windows, bool withMarks, std::size_t maxBytes)
+        : maxKeys_(std::min(windows, keysWithin(maxBytes, withMarks))),
+          keys_(slotsFor(maxKeys_)), marks_(withMarks ? keys_.size() : 0) {}
+
+    // Passes needed so that one pass expects at most the keys that fit
+    std::size_t passesFor(std::size_t windows) const { return (windows + maxKeys_ - 1) / maxKeys_; }
+
+    // Empties the map for pass `pass` of `passes` over the given number of windows
+    void reset(std::size_t windows, std::size_t pass, std::size_t passes) {
+        capacity_ = slotsFor(std::min(windows, maxKeys_));
+        size_ = 0;
+        pass_ = pass;
+        passes_ = passes;
+        std::fill(keys_.begin(), keys_.begin() + capacity_, kEmpty);
+    }
+
+    // Whether this fingerprint belongs to the current pass. Windows differing
+    // only in their last byte have adjacent fingerprints, so the value is
+    // mixed (with a different multiplier than home) before it is split
+    bool owns(std::uint64_t hash) const {
+        if (passes_ == 1) return true;
+        std::uint64_t mixed = hash * 0xD6E8FEB86659FD93ULL;
+        return static_cast<std::size_t>((static_cast<unsigned __int128>(mixed) * passes_) >> 64) == pass_;
+    }
+
+    // Slot holding this fingerprint, or the empty slot where it would go
+    std::size_t find(std::uint64_t hash) const {
+        std::size_t slot = home(hash);
+        while (keys_[slot] != kEmpty && keys_[slot] != hash) {
+            if (++slot == capacity_) slot = 0;
+        }
+        return slot;
+    }
+
+    bool occupied(std::size_t slot) const { return keys_[slot] != kEmpty; }
+
+    // True once only the one empty slot that ends every probe sequence is left
+    bool full() const { return size_ + 1 >= capacity_; }
+
+    // Unconditional: testing owns() here first measured twice as slow
+    void prefetch(std::uint64_t hash) const { __builtin_prefetch(&keys_[home(hash)]); }
+
+    void insert(std::size_t slot, std::uint64_t hash) {
+        keys_[slot] = hash;
+        if (!marks_.empty()) marks_[slot] = 0;
+        ++size_;
+    }
+
+    // How many texts in a row this fingerprint has been found in (withMarks only)
+    std::uint32_t& mark(std::size_t slot) { return marks_[slot]; }
+
+private:
+    static constexpr std::uint64_t kEmpty = ~0ULL; // Never a hash, which is below p
+
+    // Load factor at most 1/2: linear probing slows down sharply beyond that
+    static std::size_t slotsFor(std::size_t keys) { return 2 * keys + 1; }
+
+    static std::size_t keysWithin(std::size_t bytes, bool withMarks) {
+        std::size_t slots = bytes / (sizeof(std::uint64_t) + (withMarks ? sizeof(std::uint32_t) : 0));
+        return std::max<std::size_t>(slots / 2, 1);
+    }
+
+    // Multiplicatively mixed hash scaled onto [0, capacity_) without a division
+    std::size_t home(std::uint64_t hash) const {
+        return static_cast<std::size_t>(
+            (static_cast<unsigned __int128>(hash * 0x9E3779B97F4A7C15ULL) * capacity_) >> 64);
+    }
+
+    std::size_t maxKeys_;
+    std::vector<std::uint64_t> keys_;
+    std::vector<std::uint32_t> marks_;
+    std::size_t capacity_ = 0;
+    std::size_t size_ = 0;
+    std::size_t pass_ = 0;
+    std::size_t passes_ = 1;
+};
+
+// Windows hashed ahead of the one being visited, so their slots can be prefetched
+constexpr std::size_t kLookahead = 16;
+
+/**
+ * @brief Calls visit(j, hash) for every window of len bytes, left to right,
+ * until visit returns false.
+ *
+ * The rolling hash runs kLookahead windows ahead of visit. With a map, the
+ * slot of each hash is prefetched that far in advance: the map is usually
+ * far larger than the cache, and otherwise every lookup waits on a miss.
+ * @return false if visit stopped the scan early.
+ */
+template <typename Visit>
+bool forEachWindow(std::string_view text, std::size_t len, std::uint64_t base, Visit visit,
+                   const FingerprintMap* map = nullptr) {
+    std::size_t n = text.size();
+    if (len == 0 || len > n) return true;
+    std::size_t windows = n - len + 1;
+    std::uint64_t h = power(base, len - 1); // h = base^(len-1) % p
+    std::uint64_t outgoing[256];
+    for (int c = 0; c < 256; ++c) outgoing[c] = mulMod(c, h);
+
+    std::uint64_t ahead[kLookahead];
+    std::uint64_t hash = windowHash(text.data(), len, base);
+    std::size_t hashed = 0; // Windows hashed so far
+    auto hashNext = [&] {
+        if (hashed > 0) {
+            std::size_t j = hashed - 1;
+            hash = appendByte(hash + p - outgoing[static_cast<unsigned char>(text[j])], base, text[j + len]);
+        }
+        ahead[hashed % kLookahead] = hash;
+        if (map != nullptr) map->prefetch(hash);
+        ++hashed;
+    };
+    while (hashed < std::min(windows, kLookahead)) hashNext();
+
+    for (std::size_t j = 0; j < windows; ++j) {
+        std::uint64_t current = ahead[j % kLookahead];
+        if (hashed < windows) hashNext();
+        if (!visit(j, current)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Position of the first window of len bytes with this fingerprint,
+ * or text.size() if there is none.
+ */
+std::size_t firstWindowWith(std::string_view text, std::size_t len, std::uint64_t base, std::uint64_t target) {
+    std::size_t found = text.size();
+    forEachWindow(text, len, base, [&](std::size_t j, std::uint64_t hash) {
+        if (hash != target) return true;
+        found = j;
+        return false;
+    });
+    return found;
+}
+
+/**
+ * @brief Finds a longest substring that occurs at least twice in text
+ * (occurrences may overlap), in O(n log n) expected time.
+ *
+ * Binary search over the length: a probe hashes every window of that
+ * length into a FingerprintMap and stops at the first fingerprint seen
+ * twice. Equal windows always have equal fingerprints, so a "no" is always
+ * right and no repeat is longer than the length found. A "yes" may come
+ * from a collision, so the final pair of windows is compared byte by byte
+ * (Las Vegas); on a mismatch the search reruns with a new base.
+ *
+ * The table takes min(16 n, maxTableBytes) bytes. Past about
+ * maxTableBytes / 16 windows, each probe scans the text once per
+ * FingerprintMap pass, trading time for the memory bound.
+ * @return The length and the first two positions of the repeat.
+ */
+SubstringMatch longestRepeatedSubstring(std::string_view text, std::size_t maxTableBytes = kMaxTableBytes) {
+    std::size_t n = text.size();
+    if (n < 2) return {};
+    FingerprintMap seen(n, false, maxTableBytes);
+    for (;;) {
+        std::uint64_t base = randomBase();
+        std::uint64_t repeatHash = 0, second = 0;
+        auto probe = [&](std::size_t len) {
+            std::size_t windows = n - len + 1;
+            // A pass that overflows its table is retried with twice as many passes
+            for (std::size_t passes = seen.passesFor(windows);; passes *= 2) {
+                bool overflow = false;
+                for (std::size_t pass = 0; pass < passes; ++pass) {
+                    seen.reset(windows, pass, passes);
+                    bool stopped = !forEachWindow(text, len, base, [&](std::size_t j, std::uint64_t hash) {
+                        if (!seen.owns(hash)) return true;
+                        std::size_t slot = seen.find(hash);
+                        if (!seen.occupied(slot)) {
+                            if (seen.full()) {
+                                overflow = true;
+                                return false;
+                            }
+                            seen.insert(slot, hash);
+                            return true;
+                        }
+                        repeatHash = hash;
+                        second = j;
+                        return false;
+                    }, &seen);
+                    if (overflow) break;
+                    if (stopped) return true;
+                }
+                if (!overflow) return false;
+            }
+        };
+
+        // Some length-lo window repeats (by fingerprint); no length-hi window does
+        std::size_t lo = 0, hi = n;
+        std::uint64_t bestHash = 0, bestSecond = 0;
+        while (hi - lo > 1) {
+            std::size_t mid = lo + (hi - lo) / 2;
+            if (probe(mid)) {
+                lo = mid;
+                bestHash = repeatHash;
+                bestSecond = second;
+            } else {
+                hi = mid;
+            }
+        }
+
+        if (lo == 0) return {};
+        // Las Vegas: locate the earlier window and verify the pair deterministically
+        std::uint64_t bestFirst = firstWindowWith(text, lo, base, bestHash);
+        if (std::memcmp(text.data() + bestFirst, text.data() + bestSecond, lo) == 0) {
+            return {lo, {bestFirst, bestSecond}};
+        }
+    }
+}
+
+/**
+ * @brief Finds a longest substring common to every text, in O(N log n)
+ * expected time for N total bytes and shortest text length n.
+ *
+ * Each probe puts the windows of the shortest text into a FingerprintMap,
+ * then scans the other texts in turn, marking fingerprints found in every
+ * text so far. As in longestRepeatedSubstring, only "yes" answers can be
+ * wrong, so the final candidate is located in each text by a verified
+ * scan (Las Vegas), and the search reruns with a new base if it is missing.
+ *
+ * The table takes min(16 n, maxTableBytes) bytes (24 n with three or
+ * more texts); larger probes run in several passes over every text.
+ * @return The length and, for each text, the first position of the substring.
+ */
+SubstringMatch longestCommonSubstring(const std::vector<std::string_view>& texts,
+                                      std::size_t maxTableBytes = kMaxTableBytes) {
+    if (texts.empty()) return {};
+    std::size_t ref = 0; // The shortest text keeps the map small
+    for (std::size_t k = 1; k < texts.size(); ++k) {
+        if (texts[k].size() < texts[ref].size()) ref = k;
+    }
+    std::size_t shortest = texts[ref].size();
+    if (shortest == 0) return {};
+    bool withMarks = texts.size() > 2; // With two texts every hit survives
+    FingerprintMap common(shortest, withMarks, maxTableBytes);
+    for (;;) {
+        std::uint64_t base = randomBase();
+        std::uint64_t found = 0;
+        // Whether some fingerprint owned by the current pass is in every text
+        auto probePass = [&](std::size_t len, bool& overflow) {
+            forEachWindow(texts[ref], len, base, [&](std::size_t, std::uint64_t hash) {
+                if (!common.owns(hash)) return true;
+                std::size_t slot = common.find(hash);
+                if (!common.occupied(slot)) {
+                    if (common.full()) {
+                        overflow = true;
+                        return false;
+                    }
+                    common.insert(slot, hash);
+                }
+                found = hash; // Only kept for a single text
+                return true;
+            }, &common);
+            if (overflow) return false;
+            std::uint32_t round = 0;
+            for (std::size_t k = 0; k < texts.size(); ++k) {
+                if (k == ref) continue;
+                ++round;
+                bool any = false;
+                forEachWindow(texts[k], len, base, [&](std::size_t, std::uint64_t hash) {
+                    if (!common.owns(hash)) return true;
+                    std::size_t slot = common.find(hash);
+                    if (!common.occupied(slot)) return true;
+                    if (withMarks) {
+                        if (common.mark(slot) != round - 1) return true;
+                        common.mark(slot) = round;
+                    }
+                    found = hash;
+                    any = true;
+                    return true;
+                }, &common);
+                if (!any) return false;
+            }
+            return true;
+        };
+        auto probe = [&](std::size_t len) {
+            std::size_t windows = shortest - len + 1;
+            // A pass that overflows its table is retried with twice as many passes
+            for (std::size_t passes = common.passesFor(windows);; passes *= 2) {
+                bool overflow = false;
+                for (std::size_t pass = 0; pass < passes && !overflow; ++pass) {
+                    common.reset(windows, pass, passes);
+                    if (probePass(len, overflow)) return true;
+                }
+                if (!overflow) return false;
+            }
+        };
+
+        // Some length-lo window is common (by fingerprint); no length-hi window is
+        std::size_t lo = 0, hi = shortest + 1;
+        std::uint64_t bestHash = 0;
+        while (hi - lo > 1) {
+            std::size_t mid = lo + (hi - lo) / 2;
+            if (probe(mid)) {
+                lo = mid;
+                bestHash = found;
+            } else {
+                hi = mid;
+            }
+        }
+
+        if (lo == 0) return {};
+        // Las Vegas: find a verified occurrence of the candidate in every text
+        const char* candidate = texts[ref].data() + firstWindowWith(texts[ref], lo, base, bestHash);
+        SubstringMatch result{lo, std::vector<std::uint64_t>(texts.size())};
+        bool verified = true;
+        for (std::size_t k = 0; k < texts.size() && verified; ++k) {
+            verified = !forEachWindow(texts[k], lo, base, [&](std::size_t j, std::uint64_t hash) {
+                if (hash == bestHash && std::memcmp(texts[k].data() + j, candidate, lo) == 0) {
+                    result.positions[k] = j;
+                    return false;
+                }
+                return true;
+            });
+        }
+        if (verified) return result;
+    }
+}
+
+/**
+ * @brief Finds a longest substring common to every string.
+ */
+SubstringMatch longestCommonSubstring(const std::vector<std::string>& texts,
+                                      std::size_t maxTableBytes = kMaxTableBytes) {
+    return longestCommonSubstring(std::vector<std::string_view>(texts.begin(), texts.end()), maxTableBytes);
+}
+
+// --- Streaming search ---
+
+/**
+ * @brief Finds guaranteed occurrences of a pattern in a stream of any size
+ * (a file, a pipe, std::cin) using Karp-Rabin.
+ *
+ * The input is read in chunks of chunkSize bytes into one buffer that
+ * also holds the last m - 1 bytes of the previous chunk, so matches that
+ * straddle a chunk boundary are still found and verified. The rolling
+ * hash carries over between chunks. Memory use is O(chunkSize + m),
+ * independent of the stream length.
+ * @param onMatch Called with the absolute 0-based offset of each match, in order.
+ * @return The number of matches.
+ */
+std::uint64_t karpRabinLasVegasStream(std::istream& input, const std::string& pattern,
+                                      const std::function<void(std::uint64_t offset)>& onMatch,
+                                      std::size_t chunkSize = 1 << 20) {
+    std::size_t m = pattern.length();
+    if (m == 0) return 0;
+    chunkSize = std::max<std::size_t>(chunkSize, 1);
+
+    std::uint64_t base = randomBase();
+    std::uint64_t h = power(base, m - 1); // h = base^(m-1) % p
+    std::uint64_t outgoing[256];
+    for (int c = 0; c < 256; ++c) outgoing[c] = mulMod(c, h);
+    std::uint64_t patternHash = 0;
+    for (char c : pattern) patternHash = appendByte(patternHash, base, c);
+
+    // buffer = [bytes carried from the previous chunk | new chunk]
+    std::vector<char> buffer(m - 1 + chunkSize);
+    std::size_t carried = 0;
+    std::uint64_t consumed = 0; // Absolute offset of buffer[carried]
+    std::uint64_t hash = 0;     // Hash of the last min(seen, m - 1) bytes
+    std::uint64_t count = 0;
+
+    while (input.read(buffer.data() + carried, chunkSize), input.gcount() > 0) {
+        std::size_t end = carried + static_cast<std::size_t>(input.gcount());
+        for (std::size_t k = carried; k < end; ++k) {
+            hash = appendByte(hash, base, buffer[k]);
+            std::uint64_t seen = consumed + (k - carried) + 1;
+            if (seen < m) continue;
+
+            // The window buffer[k - m + 1 .. k] is complete
+            std::size_t start = k + 1 - m;
+            if (hash == patternHash && std::memcmp(buffer.data() + start, pattern.data(), m) == 0) {
+                ++count;
+                if (onMatch) onMatch(seen - m);
+            }
+
+            // Drop the leading byte, leaving the hash of the last m - 1 bytes
+            hash += p - outgoing[static_cast<unsigned char>(buffer[start])];
+            if (hash >= p) hash -= p;
+        }
+
+        // Keep the last m - 1 bytes for windows that straddle the boundary
+        consumed += end - carried;
+        std::size_t keep = std::min<std::size_t>(m - 1, end);
+        std::memmove(buffer.data(), buffer.data() + end - keep, keep);
+        carried = keep;
+    }
+    return count;
+}
+
 // Main function to demonstrate the algorithm
 int main() {
     std::string text = "abacaabaccabacabaabb";
@@ -92,13 +831,13 @@ int main() {
     std::cout << "Text:    " << text << std::endl;
     std::cout << "Pattern: " << pattern << std::endl;
 
-    std::vector<int> matches = karpRabinLasVegas(text, pattern);
+    std::vector<std::uint64_t> matches = karpRabinLasVegas(text, pattern);
 
     std::cout << "Karp-Rabin (Las Vegas) matches found at indices: ";
     if (matches.empty()) {
         std::cout << "None";
     } else {
-        for (int index : matches) {
+        for (std::uint64_t index : matches) {
             std::cout << index << " ";
         }
     }
@@ -109,10 +848,61 @@ int main() {
     std::string pattern2 = "BBAA";
     std::cout << "\nText:    " << text2 << std::endl;
     std::cout << "Pattern: " << pattern2 << std::endl;
-    std::vector<int> matches2 = karpRabinLasVegas(text2, pattern2);
+    std::vector<std::uint64_t> matches2 = karpRabinLasVegas(text2, pattern2);
     std::cout << "Karp-Rabin (Las Vegas) matches: ";
-    for (int index : matches2) std::cout << index << " ";
+    for (std::uint64_t index : matches2) std::cout << index << " ";
     std::cout << "(Note: guaranteed correct)" << std::endl;
 
+    // Several patterns of two lengths, found in one pass per length
+    std::vector<std::string> patterns = {"aba", "cab", "abb", "bacab"};
+    std::cout << "\nText:     " << text << std::endl;
+    std::cout << "Patterns: aba cab abb bacab" << std::endl;
+    std::cout << "Multi-pattern matches (index:pattern): ";
+    for (const PatternMatch& match : karpRabinLasVegasMulti(text, patterns)) {
+        std::cout << match.position << ":" << patterns[match.pattern] << " ";
+    }
+    std::cout << std::endl;
+
+    // Streaming: 4-byte chunks, so most matches straddle a chunk boundary
+    std::istringstream stream(text);
+    std::cout << "\nStreaming search for " << pattern << " in 4-byte chunks: ";
+    karpRabinLasVegasStream(stream, pattern, [](std::uint64_t offset) { std::cout << offset << " "; }, 4);
+    std::cout << std::endl;
+
+    // Search a file through a memory mapping instead of reading it into a string
+    std::string path = std::filesystem::temp_directory_path().string() + "/las_vegas_demo.txt";
+    std::ofstream(path, std::ios::binary) << text;
+    std::vector<std::uint64_t> fileMatches;
+    if (karpRabinLasVegasFile(path, pattern, fileMatches)) {
+        std::cout << "\nKarp-Rabin (Las Vegas) matches in a memory-mapped file: ";
+        for (std::uint64_t index : fileMatches) std::cout << index << " ";
+        std::cout << std::endl;
+    }
+    std::filesystem::remove(path);
+
+    // Parallel search over a larger text, checked against the serial scan
+    std::string big;
+    for (int i = 0; i < 400000; ++i) big += text;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::uint64_t> serial = karpRabinLasVegas(big, pattern);
+    auto serialTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    std::vector<std::uint64_t> parallel = karpRabinLasVegasParallel(big.data(), big.size(), pattern);
+    auto parallelTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "\nParallel search over " << big.size() << " bytes: " << parallel.size() << " matches ("
+              << (parallel == serial ? "same as serial" : "MISMATCH") << "), " << serialTime << " ms serial, "
+              << parallelTime << " ms parallel" << std::endl;
+
+    // Longest repeated substring of one text, longest common substring of several
+    SubstringMatch repeat = longestRepeatedSubstring(text);
+    std::cout << "\nLongest repeated substring: \"" << text.substr(repeat.positions[0], repeat.length)
+              << "\" at " << repeat.positions[0] << " and " << repeat.positions[1] << std::endl;
+    std::vector<std::string> texts = {text, "ccabacaab", "bbcabacx"};
+    SubstringMatch shared = longestCommonSubstring(texts);
+    std::cout << "Longest common substring of " << texts.size() << " texts: \""
+              << text.substr(shared.positions[0], shared.length) << "\" at";
+    for (std::uint64_t position : shared.positions) std::cout << " " << position;
+    std::cout << std::endl;
+
     return 0;
 }
\ No newline at end of file
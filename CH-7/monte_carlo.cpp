@@ -11,54 +11,101 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <thread>
+#include <random>       // For std::random_device, std::mt19937_64
+#include <fstream>
+#include <filesystem>   // For the demo's temporary file
 
-// We use long long to avoid overflow during intermediate calculations
-using ll = long long;
+// POSIX memory mapping for the file search
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-// d: size of the alphabet (e.g., 256 for ASCII)
-const int d = 256;
-// p: A large prime number for the modulo operation
-const ll p = 1000000007;
+// p: the Mersenne prime 2^61 - 1. Reduction modulo p needs only shifts and
+// adds, and two different m-byte strings get the same hash with probability
+// at most (m - 1) / p over the random base (below 2^-50 for m < 2048).
+const std::uint64_t p = (1ULL << 61) - 1;
 
 /**
- * @brief Helper function to compute (base^exp) % mod efficiently.
+ * @brief Computes (a * b) % p for a, b < 2^62 with one 128-bit multiply,
+ * folding the high bits down using 2^61 = 1 (mod p).
  */
-ll power(ll base, ll exp) {
-    ll res = 1;
-    base %= p;
+inline std::uint64_t mulMod(std::uint64_t a, std::uint64_t b) {
+    unsigned __int128 x = static_cast<unsigned __int128>(a) * b;
+    std::uint64_t t = static_cast<std::uint64_t>(x & p) + static_cast<std::uint64_t>(x >> 61);
+    t = (t & p) + (t >> 61);
+    return t >= p ? t - p : t;
+}
+
+/**
+ * @brief Computes (hash * base + c) % p: appends byte c to a hash.
+ * hash may be anything below 2p.
+ */
+inline std::uint64_t appendByte(std::uint64_t hash, std::uint64_t base, unsigned char c) {
+    std::uint64_t x = mulMod(hash, base) + c;
+    return x >= p ? x - p : x;
+}
+
+/**
+ * @brief Helper function to compute (base^exp) % p efficiently.
+ */
+std::uint64_t power(std::uint64_t base, std::uint64_t exp) {
+    std::uint64_t res = 1;
     while (exp > 0) {
-        if (exp % 2 == 1) res = (res * base) % p;
-        base = (base * base) % p;
+        if (exp % 2 == 1) res = mulMod(res, base);
+        base = mulMod(base, base);
         exp /= 2;
     }
     return res;
 }
 
+/**
+ * @brief Draws the hash base uniformly from [256, p). A fresh base for each
+ * search is what makes the collision bound hold for every input, so the
+ * generator gets 128 bits from std::random_device: a clock seed would allow
+ * only 2^32 bases and repeat the base for searches started together.
+ */
+std::uint64_t randomBase() {
+    std::random_device device;
+    std::seed_seq seeds{device(), device(), device(), device()};
+    std::mt19937_64 generator(seeds);
+    std::uniform_int_distribution<std::uint64_t> distribution(256, p - 1);
+    return distribution(generator);
+}
+
 /**
  * @brief Finds potential occurrences of a pattern in a text using Karp-Rabin.
- * @param text The text string to search in.
+ * @param text The text to search in: n bytes, e.g. a memory-mapped file.
+ * @param n The length of the text; offsets are 64-bit, so n may exceed 2 GB.
  * @param pattern The pattern string to search for.
  * @return A vector of indices where a hash match occurred.
  */
-std::vector<int> karpRabinMonteCarlo(const std::string& text, const std::string& pattern) {
-    std::vector<int> matches;
-    int n = text.length();
-    int m = pattern.length();
+std::vector<std::uint64_t> karpRabinMonteCarlo(const char* text, std::size_t n, const std::string& pattern) {
+    std::vector<std::uint64_t> matches;
+    std::size_t m = pattern.length();
     
     if (m == 0 || m > n) return matches;
 
-    ll patternHash = 0;
-    ll textHash = 0;
-    ll h = power(d, m - 1); // h = d^(m-1) % p
+    std::uint64_t base = randomBase();
+    std::uint64_t h = power(base, m - 1); // h = base^(m-1) % p
+
+    // outgoing[c] = c * h % p: what a leading byte c contributes to the window
+    std::uint64_t outgoing[256];
+    for (int c = 0; c < 256; ++c) outgoing[c] = mulMod(c, h);
 
     // Calculate the hash value of the pattern and the first window of the text
-    for (int i = 0; i < m; ++i) {
-        patternHash = (d * patternHash + pattern[i]) % p;
-        textHash = (d * textHash + text[i]) % p;
+    std::uint64_t patternHash = 0;
+    std::uint64_t textHash = 0;
+    for (std::size_t i = 0; i < m; ++i) {
+        patternHash = appendByte(patternHash, base, pattern[i]);
+        textHash = appendByte(textHash, base, text[i]);
     }
 
     // Slide the pattern over the text one by one
-    for (int j = 0; j <= n - m; ++j) {
+    for (std::size_t j = 0; j <= n - m; ++j) {
         
         // Check if the hash values match
         if (patternHash == textHash) {
@@ -68,17 +115,244 @@ std::vector<int> karpRabinMonteCarlo(const std::string& text, const std::string&
 
         // Calculate the hash value for the next window
         if (j < n - m) {
-            // Remove leading digit, add trailing digit
-            // textHash = (d * (textHash - text[j] * h) + text[j + m]) % p;
-            
-            ll term1 = (textHash - (ll)text[j] * h) % p;
-            ll term2 = (d * (term1 + p)) % p; // Add p to handle potential negative
-            textHash = (term2 + text[j + m]) % p;
+            // Remove leading byte, add trailing byte: (textHash - text[j] * h) * base + text[j + m]
+            textHash = appendByte(textHash + p - outgoing[static_cast<unsigned char>(text[j])], base, text[j + m]);
         }
     }
     return matches;
 }
 
+/**
+ * @brief Finds potential occurrences of a pattern in a string.
+ */
+std::vector<std::uint64_t> karpRabinMonteCarlo(const std::string& text, const std::string& pattern) {
+    return karpRabinMonteCarlo(text.data(), text.size(), pattern);
+}
+
+// --- Searching memory-mapped files (POSIX) ---
+
+/**
+ * @brief A read-only mapping of a whole file. The search runs directly over
+ * the mapped pages, so the file is never copied into a std::string.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    // Maps the file at path; returns false if it cannot be opened or mapped
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ > 0) {
+            void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                size_ = 0;
+                return false;
+            }
+            madvise(addr, size_, MADV_SEQUENTIAL); // One front-to-back pass: read ahead aggressively
+            data_ = static_cast<const char*>(addr);
+        }
+        ::close(fd); // The mapping stays valid after the descriptor is closed
+        return true;
+    }
+
+    void close() {
+        if (data_ != nullptr) munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/**
+ * @brief Finds potential occurrences of a pattern in a file of any size by
+ * running the search over a read-only mapping of it.
+ * @param matches Receives the 64-bit offsets of the matches.
+ * @return false if the file cannot be opened or mapped.
+ */
+bool karpRabinMonteCarloFile(const std::string& path, const std::string& pattern, std::vector<std::uint64_t>& matches) {
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    matches = karpRabinMonteCarlo(file.data(), file.size(), pattern);
+    return true;
+}
+
+// --- Prefix-hash index ---
+
+/**
+ * @brief Prefix hashes of one text, for O(1) fingerprints of any substring.
+ *
+ * prefix[k] is the hash of the first k bytes and powers[k] = base^k, so
+ *     hash(text[i, i + len)) = prefix[i + len] - prefix[i] * base^len  (mod p).
+ * Building costs O(n) once (16 bytes of index per text byte); afterwards a
+ * substring fingerprint or equality test is two multiplies. Equality is
+ * Monte Carlo: two different substrings of length len compare equal with
+ * probability at most (len - 1) / p over the base drawn at build time.
+ */
+class PrefixHashIndex {
+public:
+    /**
+     * @brief Indexes n bytes of text under a fresh random base.
+     *
+     * With several threads, each chunk first hashes its own bytes as if it
+     * started the text, and fills its slice of the power table from
+     * base^start. A serial pass over the chunk ends then gives the true hash
+     * in front of each chunk, and every chunk adds that value times
+     * base^k to its local prefixes.
+     * @param numThreads Threads to use; 0 means one per hardware thread.
+     */
+    void build(const char* text, std::size_t n, unsigned numThreads = 1) {
+        base_ = randomBase();
+        prefix_.assign(n + 1, 0);
+        powers_.assign(n + 1, 1);
+        if (numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+        numThreads = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(numThreads, n / kMinBytesPerThread)));
+        std::size_t chunk = (n + numThreads - 1) / numThreads;
+        auto chunkBegin = [&](unsigned t) { return std::min(n, t * chunk); };
+
+        // Pass 1: chunk-local prefixes and the power table
+        forEachChunk(numThreads, [&](unsigned t) {
+            std::size_t begin = chunkBegin(t), end = chunkBegin(t + 1);
+            std::uint64_t hash = 0;
+            std::uint64_t pw = power(base_, begin);
+            for (std::size_t i = begin; i < end; ++i) {
+                hash = appendByte(hash, base_, text[i]);
+                prefix_[i + 1] = hash;
+                pw = mulMod(pw, base_);
+                powers_[i + 1] = pw;
+            }
+        });
+
+        // Hash of everything before each chunk, chained across chunks
+        std::vector<std::uint64_t> carry(numThreads, 0);
+        for (unsigned t = 1; t < numThreads; ++t) {
+            std::size_t begin = chunkBegin(t - 1), end = chunkBegin(t);
+            carry[t] = addMod(mulMod(carry[t - 1], powers_[end - begin]), prefix_[end]);
+        }
+
+        // Pass 2: prefix[begin + k] = carry * base^k + local[k]
+        forEachChunk(numThreads, [&](unsigned t) {
+            if (carry[t] == 0) return;
+            for (std::size_t i = chunkBegin(t), k = 1; i < chunkBegin(t + 1); ++i, ++k) {
+                prefix_[i + 1] = addMod(mulMod(carry[t], powers_[k]), prefix_[i + 1]);
+            }
+        });
+    }
+
+    // Length of the indexed text
+    std::size_t size() const { return prefix_.empty() ? 0 : prefix_.size() - 1; }
+
+    /**
+     * @brief Fingerprint of text[i, i + len); requires i + len <= size().
+     */
+    std::uint64_t substringHash(std::size_t i, std::size_t len) const {
+        return addMod(prefix_[i + len], p - mulMod(prefix_[i], powers_[len]));
+    }
+
+    /**
+     * @brief Whether text[i, i + len) == text[j, j + len), by fingerprint.
+     */
+    bool substringEqual(std::size_t i, std::size_t j, std::size_t len) const {
+        return substringHash(i, len) == substringHash(j, len);
+    }
+
+    /**
+     * @brief Fingerprint of an outside string under this index's base, to
+     * compare against substringHash. Compute it once per pattern.
+     */
+    std::uint64_t fingerprint(const std::string& s) const {
+        std::uint64_t hash = 0;
+        for (char c : s) hash = appendByte(hash, base_, c);
+        return hash;
+    }
+
+    /**
+     * @brief Writes the index to a binary file, so it can be reused without
+     * rebuilding. The file holds the base, the length and both tables.
+     * @return false if the file cannot be written.
+     */
+    bool save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary);
+        std::uint64_t header[3] = {kMagic, base_, size()};
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(prefix_.data()), prefix_.size() * sizeof(std::uint64_t));
+        out.write(reinterpret_cast<const char*>(powers_.data()), powers_.size() * sizeof(std::uint64_t));
+        return static_cast<bool>(out);
+    }
+
+    /**
+     * @brief Reads an index written by save.
+     * @return false if the file is missing, truncated or not an index; the
+     * index is left empty in that case.
+     */
+    bool load(const std::string& path) {
+        prefix_.clear();
+        powers_.clear();
+        std::ifstream in(path, std::ios::binary);
+        std::uint64_t header[3];
+        if (!in.read(reinterpret_cast<char*>(header), sizeof(header)) || header[0] != kMagic) {
+            return false;
+        }
+        std::error_code error;
+        std::uintmax_t fileSize = std::filesystem::file_size(path, error);
+        if (error || header[2] > fileSize / (2 * sizeof(std::uint64_t)) ||
+            fileSize != sizeof(header) + 2 * (header[2] + 1) * sizeof(std::uint64_t)) {
+            return false; // Truncated, or a corrupt length
+        }
+        std::vector<std::uint64_t> prefix(header[2] + 1), powers(header[2] + 1);
+        if (!in.read(reinterpret_cast<char*>(prefix.data()), prefix.size() * sizeof(std::uint64_t)) ||
+            !in.read(reinterpret_cast<char*>(powers.data()), powers.size() * sizeof(std::uint64_t))) {
+            return false;
+        }
+        base_ = header[1];
+        prefix_ = std::move(prefix);
+        powers_ = std::move(powers);
+        return true;
+    }
+
+private:
+    // "KRPHIDX1": identifies an index file and its layout version
+    static constexpr std::uint64_t kMagic = 0x315844494850524BULL;
+    // Threads are only worth starting for at least this many bytes each
+    static constexpr std::size_t kMinBytesPerThread = 1 << 20;
+
+    static std::uint64_t addMod(std::uint64_t a, std::uint64_t b) {
+        std::uint64_t x = a + b;
+        return x >= p ? x - p : x;
+    }
+
+    template <typename F>
+    static void forEachChunk(unsigned numThreads, F work) {
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < numThreads; ++t) threads.emplace_back(work, t);
+        work(0u);
+        for (auto& thread : threads) thread.join();
+    }
+
+    std::uint64_t base_ = 0;
+    std::vector<std::uint64_t> prefix_; // prefix_[k] = hash of text[0, k)
+    std::vector<std::uint64_t> powers_; // powers_[k] = base^k % p
+};
+
 // Main function to demonstrate the algorithm
 int main() {
     std::string text = "abacaabaccabacabaabb";
@@ -87,13 +361,13 @@ int main() {
     std::cout << "Text:    " << text << std::endl;
     std::cout << "Pattern: " << pattern << std::endl;
 
-    std::vector<int> matches = karpRabinMonteCarlo(text, pattern);
+    std::vector<std::uint64_t> matches = karpRabinMonteCarlo(text, pattern);
 
     std::cout << "Karp-Rabin (Monte Carlo) matches found at indices: ";
     if (matches.empty()) {
         std::cout << "None";
     } else {
-        for (int index : matches) {
+        for (std::uint64_t index : matches) {
             std::cout << index << " ";
         }
     }
@@ -104,11 +378,37 @@ int main() {
     std::string pattern2 = "BBAA"; // Hash might collide with "AACA"
     std::cout << "\nText:    " << text2 << std::endl;
     std::cout << "Pattern: " << pattern2 << std::endl;
-    std::vector<int> matches2 = karpRabinMonteCarlo(text2, pattern2);
+    std::vector<std::uint64_t> matches2 = karpRabinMonteCarlo(text2, pattern2);
     std::cout << "Karp-Rabin (Monte Carlo) matches: ";
-    for (int index : matches2) std::cout << index << " ";
+    for (std::uint64_t index : matches2) std::cout << index << " ";
     std::cout << "(Note: may contain false positives)" << std::endl;
 
+    // Search a file through a memory mapping instead of reading it into a string
+    std::string path = std::filesystem::temp_directory_path().string() + "/monte_carlo_demo.txt";
+    std::ofstream(path, std::ios::binary) << text;
+    std::vector<std::uint64_t> fileMatches;
+    if (karpRabinMonteCarloFile(path, pattern, fileMatches)) {
+        std::cout << "\nKarp-Rabin (Monte Carlo) matches in a memory-mapped file: ";
+        for (std::uint64_t index : fileMatches) std::cout << index << " ";
+        std::cout << std::endl;
+    }
+    std::filesystem::remove(path);
+
+    // Index the text once, then answer substring queries in O(1)
+    PrefixHashIndex index;
+    index.build(text.data(), text.size());
+    std::uint64_t patternHash = index.fingerprint(pattern);
+    std::cout << "\nPrefix-hash index: pattern at 10? " << (index.substringHash(10, pattern.size()) == patternHash)
+              << ", text[0, 4) == text[10, 14)? " << index.substringEqual(0, 10, 4)
+              << ", text[0, 4) == text[1, 5)? " << index.substringEqual(0, 1, 4) << std::endl;
+
+    std::string indexPath = std::filesystem::temp_directory_path().string() + "/monte_carlo_demo.idx";
+    PrefixHashIndex loaded;
+    if (index.save(indexPath) && loaded.load(indexPath)) {
+        std::cout << "Reloaded index of " << loaded.size() << " bytes: pattern at 10? "
+                  << (loaded.substringHash(10, pattern.size()) == patternHash) << std::endl;
+    }
+    std::filesystem::remove(indexPath);
 
     return 0;
 }
\ No newline at end of file
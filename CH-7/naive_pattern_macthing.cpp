@@ -8,25 +8,35 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <filesystem>   // For the demo's temporary file
+
+// POSIX memory mapping for the file search
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 /**
  * @brief Finds all occurrences of a pattern in a text using the naive method.
- * @param text The text string to search in.
+ * @param text The text to search in: n bytes, e.g. a memory-mapped file.
+ * @param n The length of the text; offsets are 64-bit, so n may exceed 2 GB.
  * @param pattern The pattern string to search for.
  * @return A vector of 0-based indices where the pattern starts in the text.
  */
-std::vector<int> naivePatternMatch(const std::string& text, const std::string& pattern) {
-    std::vector<int> matches;
-    int n = text.length();
-    int m = pattern.length();
+std::vector<std::uint64_t> naivePatternMatch(const char* text, std::size_t n, const std::string& pattern) {
+    std::vector<std::uint64_t> matches;
+    std::size_t m = pattern.length();
 
-    if (m == 0) return matches;
+    if (m == 0 || m > n) return matches;
 
     // Loop through all possible starting positions in the text
-    for (int j = 0; j <= n - m; ++j) {
+    for (std::size_t j = 0; j <= n - m; ++j) {
         
         // Check for a match starting at index j
-        int i;
+        std::size_t i;
         for (i = 0; i < m; ++i) {
             if (text[j + i] != pattern[i]) {
                 break; // Mismatch, break inner loop
@@ -41,6 +51,80 @@ std::vector<int> naivePatternMatch(const std::string& text, const std::string& p
     return matches;
 }
 
+/**
+ * @brief Finds all occurrences of a pattern in a string.
+ */
+std::vector<std::uint64_t> naivePatternMatch(const std::string& text, const std::string& pattern) {
+    return naivePatternMatch(text.data(), text.size(), pattern);
+}
+
+// --- Searching memory-mapped files (POSIX) ---
+
+/**
+ * @brief A read-only mapping of a whole file. The search runs directly over
+ * the mapped pages, so the file is never copied into a std::string.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    // Maps the file at path; returns false if it cannot be opened or mapped
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ > 0) {
+            void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                size_ = 0;
+                return false;
+            }
+            madvise(addr, size_, MADV_SEQUENTIAL); // One front-to-back pass: read ahead aggressively
+            data_ = static_cast<const char*>(addr);
+        }
+        ::close(fd); // The mapping stays valid after the descriptor is closed
+        return true;
+    }
+
+    void close() {
+        if (data_ != nullptr) munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/**
+ * @brief Finds all occurrences of a pattern in a file of any size by
+ * running the search over a read-only mapping of it.
+ * @param matches Receives the 64-bit offsets of the matches.
+ * @return false if the file cannot be opened or mapped.
+ */
+bool naivePatternMatchFile(const std::string& path, const std::string& pattern, std::vector<std::uint64_t>& matches) {
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    matches = naivePatternMatch(file.data(), file.size(), pattern);
+    return true;
+}
+
 // Main function to demonstrate the algorithm
 int main() {
     std::string text = "abacaabaccabacabaabb";
@@ -49,17 +133,28 @@ int main() {
     std::cout << "Text:    " << text << std::endl;
     std::cout << "Pattern: " << pattern << std::endl;
 
-    std::vector<int> matches = naivePatternMatch(text, pattern);
+    std::vector<std::uint64_t> matches = naivePatternMatch(text, pattern);
 
     std::cout << "Naive matches found at indices: ";
     if (matches.empty()) {
         std::cout << "None";
     } else {
-        for (int index : matches) {
+        for (std::uint64_t index : matches) {
             std::cout << index << " ";
         }
     }
     std::cout << std::endl;
 
+    // Search a file through a memory mapping instead of reading it into a string
+    std::string path = std::filesystem::temp_directory_path().string() + "/naive_pattern_macthing_demo.txt";
+    std::ofstream(path, std::ios::binary) << text;
+    std::vector<std::uint64_t> fileMatches;
+    if (naivePatternMatchFile(path, pattern, fileMatches)) {
+        std::cout << "\nNaive matches in a memory-mapped file: ";
+        for (std::uint64_t index : fileMatches) std::cout << index << " ";
+        std::cout << std::endl;
+    }
+    std::filesystem::remove(path);
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,236 @@
+/*
+ * ALGORITHM 6: Verifying Polynomial Multiplication (Schwartz-Zippel)
+ *
+ * Checks a claimed product c(x) = a(x) * b(x) (equivalently, a linear
+ * convolution c = a * b of coefficient sequences) in O(n) time, instead
+ * of recomputing it with an O(n log n) FFT/NTT or O(n^2) schoolbook pass.
+ *
+ * 1. Pick a random point r from a prime field Z_p.
+ * 2. Evaluate a(r), b(r) and c(r) with Horner's rule.
+ * 3. Accept if a(r) * b(r) = c(r).
+ *
+ * If c != a * b, then a * b - c is a nonzero polynomial of degree at
+ * most d = deg(c), so by the Schwartz-Zippel Lemma it vanishes at r with
+ * probability at most d / p. Checking k independent points gives (d / p)^k.
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>       // For std::random_device, std::mt19937_64
+#include <chrono>       // For timing the demo
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+// The Mersenne prime 2^61 - 1: reduction needs only shifts and adds
+constexpr std::uint64_t kMersenne61 = (1ULL << 61) - 1;
+
+// Field elements (or evaluation points) with entries in [0, p)
+using ModVector = std::vector<std::uint64_t>;
+
+// Points evaluated together in one pass over the coefficients
+constexpr std::size_t kPointsPerPass = 8;
+
+// --- Prime fields ---
+
+/**
+ * @brief Z_p for p = 2^61 - 1. Used to check products of integer
+ * polynomials: if a * b = c over the integers, it also holds mod p.
+ */
+struct Mersenne61Field {
+    std::uint64_t modulus() const { return kMersenne61; }
+
+    /**
+     * @brief Reduces x < 2^123 modulo 2^61 - 1 using 2^61 = 1 (mod p).
+     */
+    std::uint64_t reduce(unsigned __int128 x) const {
+        std::uint64_t t = static_cast<std::uint64_t>(x & kMersenne61) + static_cast<std::uint64_t>(x >> 61);
+        t = (t & kMersenne61) + (t >> 61);
+        return t >= kMersenne61 ? t - kMersenne61 : t;
+    }
+
+    // Maps a signed integer coefficient into [0, p)
+    std::uint64_t element(std::int64_t value) const {
+        std::int64_t r = value % static_cast<std::int64_t>(kMersenne61);
+        return static_cast<std::uint64_t>(r < 0 ? r + static_cast<std::int64_t>(kMersenne61) : r);
+    }
+};
+
+/**
+ * @brief Z_q for an arbitrary prime q < 2^63, e.g. an NTT modulus such as
+ * 998244353. Used when the product itself was computed mod q.
+ */
+struct PrimeField {
+    std::uint64_t q;
+    std::uint64_t barrett; // floor(2^64 / q), for the fast path below
+
+    explicit PrimeField(std::uint64_t modulus)
+        : q(modulus), barrett(static_cast<std::uint64_t>((static_cast<unsigned __int128>(1) << 64) / modulus)) {}
+
+    std::uint64_t modulus() const { return q; }
+
+    std::uint64_t reduce(unsigned __int128 x) const {
+        // NTT primes are usually below 2^32, so the product fits 64 bits and a
+        // Barrett reduction (two multiplies, one correction) replaces the division
+        if (x >> 64 == 0) {
+            std::uint64_t y = static_cast<std::uint64_t>(x);
+            std::uint64_t quotient = static_cast<std::uint64_t>((static_cast<unsigned __int128>(y) * barrett) >> 64);
+            std::uint64_t r = y - quotient * q;
+            return r >= q ? r - q : r;
+        }
+        return static_cast<std::uint64_t>(x % q);
+    }
+
+    std::uint64_t element(std::uint64_t value) const { return value < q ? value : value % q; }
+};
+
+// --- Multi-point Horner evaluation ---
+
+/**
+ * @brief Evaluates one polynomial at K points in a single pass over its
+ * coefficients.
+ *
+ * Horner's rule is a chain of dependent multiply-reduce steps, so one
+ * point is bound by the latency of that chain. Evaluating K points at
+ * once interleaves K independent chains, which keeps the multiplier busy
+ * and reads each coefficient once instead of K times.
+ */
+template <std::size_t K, typename Field, typename T>
+void hornerEvaluate(const Field& F, const std::vector<T>& coeffs, const std::uint64_t* points,
+                    std::uint64_t* values) {
+    std::uint64_t acc[K] = {};
+    for (std::size_t i = coeffs.size(); i-- > 0;) {
+        std::uint64_t c = F.element(coeffs[i]);
+        for (std::size_t t = 0; t < K; ++t) {
+            acc[t] = F.reduce(static_cast<unsigned __int128>(acc[t]) * points[t] + c);
+        }
+    }
+    std::copy(acc, acc + K, values);
+}
+
+/**
+ * @brief Evaluates a polynomial (coefficients in increasing degree) at
+ * every point, kPointsPerPass points per pass.
+ * @return The values, one per point, in [0, p).
+ */
+template <typename Field, typename T>
+ModVector evaluatePolynomial(const Field& F, const std::vector<T>& coeffs, const ModVector& points) {
+    ModVector values(points.size());
+    std::size_t t = 0;
+    for (; t + kPointsPerPass <= points.size(); t += kPointsPerPass) {
+        hornerEvaluate<kPointsPerPass>(F, coeffs, points.data() + t, values.data() + t);
+    }
+    for (; t < points.size(); ++t) {
+        hornerEvaluate<1>(F, coeffs, points.data() + t, values.data() + t);
+    }
+    return values;
+}
+
+// --- Verification ---
+
+/**
+ * @brief Checks a(r) * b(r) = c(r) over F at numPoints random points.
+ */
+template <typename Field, typename T>
+bool verifyProductOver(const Field& F, const std::vector<T>& a, const std::vector<T>& b, const std::vector<T>& c,
+                       std::size_t numPoints) {
+    // The product of polynomials with m and n coefficients has m + n - 1
+    if (a.empty() || b.empty()) {
+        return c.empty(); // The product with an empty polynomial is empty
+    }
+    if (c.size() != a.size() + b.size() - 1 || numPoints == 0) {
+        return false; // Invalid dimensions
+    }
+
+    // 1. Pick random points from Z_p
+    std::random_device device;
+    std::seed_seq seeds{device(), device(), device(), device()};
+    std::mt19937_64 generator(seeds);
+    std::uniform_int_distribution<std::uint64_t> distribution(0, F.modulus() - 1);
+    ModVector points(numPoints);
+    for (auto& point : points) point = distribution(generator);
+
+    // 2. Evaluate a, b and c at every point  (O((|a| + |b| + |c|) k))
+    ModVector aValues = evaluatePolynomial(F, a, points);
+    ModVector bValues = evaluatePolynomial(F, b, points);
+    ModVector cValues = evaluatePolynomial(F, c, points);
+
+    // 3. Compare a(r) * b(r) with c(r) at each point
+    for (std::size_t t = 0; t < numPoints; ++t) {
+        if (F.reduce(static_cast<unsigned __int128>(aValues[t]) * bValues[t]) != cValues[t]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Verifies that c = a * b for integer polynomials (or that c is the
+ * linear convolution of a and b).
+ *
+ * Works in Z_p with p = 2^61 - 1. A wrong c is accepted with probability
+ * at most (deg(c) / p)^numPoints, about 2^-41 per point for a million
+ * coefficients, unless every coefficient of a * b - c is a multiple of p.
+ * @return true if all points agree, false otherwise.
+ */
+bool verifyPolynomialProduct(const std::vector<std::int64_t>& a, const std::vector<std::int64_t>& b,
+                             const std::vector<std::int64_t>& c, std::size_t numPoints = 1) {
+    return verifyProductOver(Mersenne61Field{}, a, b, c, numPoints);
+}
+
+/**
+ * @brief Verifies that c = a * b mod q, for products computed with an NTT
+ * (or any other method) over Z_q with q prime.
+ *
+ * A wrong c is accepted with probability at most (deg(c) / q)^numPoints,
+ * so small moduli need several points: for q = 998244353 and a million
+ * coefficients, 4 points give about 2^-40.
+ * @return true if all points agree, false otherwise.
+ */
+bool verifyPolynomialProductModQ(const std::vector<std::uint64_t>& a, const std::vector<std::uint64_t>& b,
+                                 const std::vector<std::uint64_t>& c, std::uint64_t q, std::size_t numPoints = 1) {
+    if (q < 2 || q >> 63 != 0) {
+        return false; // Unsupported modulus
+    }
+    return verifyProductOver(PrimeField{q}, a, b, c, numPoints);
+}
+
+// Main function to demonstrate the algorithm
+int main() {
+    // Case 1: (1 + 2x + 3x^2) * (4 + 5x) = 4 + 13x + 22x^2 + 15x^3
+    std::vector<std::int64_t> a = {1, 2, 3};
+    std::vector<std::int64_t> b = {4, 5};
+    std::vector<std::int64_t> c_correct = {4, 13, 22, 15};
+    std::vector<std::int64_t> c_incorrect = {4, 13, 23, 15}; // One coefficient is wrong
+
+    std::cout << "Verifying a * b = c_correct (should be true):" << std::endl;
+    std::cout << "Result: " << (verifyPolynomialProduct(a, b, c_correct) ? "Verified" : "Failed") << std::endl;
+
+    std::cout << "\nVerifying a * b = c_incorrect (should be false):" << std::endl;
+    std::cout << "Result: " << (verifyPolynomialProduct(a, b, c_incorrect) ? "Verified" : "Failed") << std::endl;
+
+    // Case 2: a million coefficients, times (1 + x), so c[i] = a[i] + a[i - 1]
+    const std::size_t n = 1000000;
+    const std::uint64_t q = 998244353; // A common NTT prime
+    std::mt19937_64 generator(42);
+    std::vector<std::uint64_t> big(n);
+    for (auto& coeff : big) coeff = generator() % q;
+    std::vector<std::uint64_t> onePlusX = {1, 1};
+    std::vector<std::uint64_t> product(n + 1);
+    for (std::size_t i = 0; i <= n; ++i) {
+        std::uint64_t sum = (i < n ? big[i] : 0) + (i > 0 ? big[i - 1] : 0);
+        product[i] = sum % q;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    bool verified = verifyPolynomialProductModQ(big, onePlusX, product, q, 8);
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "\nVerifying a degree-" << n << " product mod " << q << " at 8 points:" << std::endl;
+    std::cout << "Result: " << (verified ? "Verified" : "Failed") << " (" << elapsed << " ms)" << std::endl;
+
+    product[n / 2] = (product[n / 2] + 1) % q;
+    std::cout << "After corrupting one coefficient: "
+              << (verifyPolynomialProductModQ(big, onePlusX, product, q, 8) ? "Verified" : "Failed") << std::endl;
+
+    return 0;
+}